@@ -0,0 +1,175 @@
+/*
+MIT License
+
+Copyright (c) 2024
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "IniLib.h"
+#include <tuple>
+
+namespace IniLib {
+
+    /**
+     * @struct IniField
+     * @brief Describes how a struct member maps to a key in an IniSection.
+     *
+     * Created with bindField, which hashes the key name at compile time.
+     *
+     * @tparam Struct The struct type owning the member.
+     * @tparam Member The type of the member.
+     */
+    template<typename Struct, typename Member>
+    struct IniField {
+        std::string_view name;   ///< Key name, as declared
+        size_t hash;             ///< Case-insensitive hash of the key name
+        Member Struct::* member; ///< Pointer to the bound member
+    };
+
+    /**
+     * @brief Creates a field descriptor binding a key name to a struct member
+     * @tparam Struct The struct type owning the member.
+     * @tparam Member The type of the member.
+     * @param name The key name
+     * @param member Pointer to the member
+     * @return IniField<Struct, Member> The field descriptor
+     */
+    template<typename Struct, typename Member>
+    constexpr IniField<Struct, Member> bindField(std::string_view name, Member Struct::* member) {
+        return IniField<Struct, Member>{ name, hashKey(name), member };
+    }
+
+    /**
+     * @struct IniBinding
+     * @brief Trait declaring the fields of a struct bound to an IniSection.
+     *
+     * Specialize it for each bound struct with a static constexpr tuple of field descriptors:
+     *
+     * @code
+     * template<>
+     * struct IniLib::IniBinding<Car> {
+     *     static constexpr auto fields = std::make_tuple(
+     *         IniLib::bindField("power", &Car::power),
+     *         IniLib::bindField("gears", &Car::gears));
+     * };
+     * @endcode
+     *
+     * Supported member types are any T with an IniValueConvert<T> specialization,
+     * std::vector<T> and fixed-size arrays T[N].
+     *
+     * @tparam Struct The bound struct type.
+     */
+    template<typename Struct>
+    struct IniBinding;
+
+    namespace detail {
+
+        template<typename T>
+        void decodeField(const IniValue& value, T& out) {
+            out = value.getAs<T>();
+        }
+
+        template<typename T>
+        void decodeField(const IniValue& value, std::vector<T>& out) {
+            out = value.getVectorAs<T>();
+        }
+
+        template<typename T, size_t N>
+        void decodeField(const IniValue& value, T(&out)[N]) {
+            if (value.length() > N) {
+                throw IniValueConvertException("Too many values for array of size " + std::to_string(N));
+            }
+            DecodeResult result = value.decodeInto(out, N);
+            if (!result.success) {
+                throw IniValueConvertException("Invalid array value: " + value[result.count]);
+            }
+        }
+
+        template<typename T>
+        void encodeField(IniValue& value, const T& in) {
+            value = in;
+        }
+
+        template<typename T>
+        void encodeField(IniValue& value, const std::vector<T>& in) {
+            value = in;
+        }
+
+        template<typename T, size_t N>
+        void encodeField(IniValue& value, const T(&in)[N]) {
+            value.clear();
+            for (size_t i = 0; i < N; ++i) {
+                value.append(IniValueConvert<T>::encode(in[i]));
+            }
+        }
+
+        template<typename Struct, typename Fields, size_t... I>
+        bool decodeMatchingField(const Fields& fields, size_t hash, const std::string& key,
+            const IniValue& value, Struct& out, std::index_sequence<I...>) {
+            // Unrolled comparison against the compile-time hashes; the name check only runs on a hash match
+            return ((std::get<I>(fields).hash == hash && keyEquals(std::get<I>(fields).name, key)
+                && (decodeField(value, out.*(std::get<I>(fields).member)), true)) || ...);
+        }
+
+    } // namespace detail
+
+    /**
+     * @brief Decodes an IniSection into a bound struct in a single traversal of the section
+     *
+     * Members whose key is missing from the section are left untouched.
+     *
+     * @tparam Struct The bound struct type, with an IniBinding specialization.
+     * @param section The section to decode
+     * @param out The struct to decode into
+     * @return size_t Number of members that were decoded
+     * @throws IniValueConvertException if a value fails to convert.
+     */
+    template<typename Struct>
+    size_t decodeSection(const IniSection& section, Struct& out) {
+        constexpr auto& fields = IniBinding<Struct>::fields;
+        constexpr size_t fieldCount = std::tuple_size<std::decay_t<decltype(fields)>>::value;
+        size_t decoded = 0;
+        for (const auto& kv : section) {
+            if (detail::decodeMatchingField(fields, hashKey(kv.first), kv.first, kv.second, out,
+                std::make_index_sequence<fieldCount>())) {
+                ++decoded;
+            }
+        }
+        return decoded;
+    }
+
+    /**
+     * @brief Encodes a bound struct into an IniSection, setting one key per member
+     * @tparam Struct The bound struct type, with an IniBinding specialization.
+     * @param in The struct to encode
+     * @param section The section to write to
+     * @throws IniValueConvertException if a value fails to convert.
+     */
+    template<typename Struct>
+    void encodeSection(const Struct& in, IniSection& section) {
+        std::apply([&](const auto&... field) {
+            (detail::encodeField(section[std::string(field.name)], in.*(field.member)), ...);
+        }, IniBinding<Struct>::fields);
+    }
+
+} // namespace IniLib
@@ -0,0 +1,211 @@
+/*
+MIT License
+
+Copyright (c) 2024
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "IniValueConvert.h"
+
+namespace IniLib {
+
+    /**
+     * @class IniFixed
+     * @brief Exact decimal number stored as a scaled 64-bit integer.
+     *
+     * IniFixed<3> holds thousandths, so "3.14" is stored as 3140. Text is parsed
+     * digit by digit into the scaled integer, without going through floating point.
+     *
+     * @tparam Decimals Number of decimal digits kept after the point.
+     */
+    template<unsigned Decimals>
+    class IniFixed {
+    public:
+        static_assert(Decimals <= 18, "IniFixed supports at most 18 decimal digits");
+
+        /// @brief Factor between the stored integer and the represented value
+        static constexpr long long scale = [] { long long s = 1; for (unsigned i = 0; i < Decimals; ++i) s *= 10; return s; }();
+
+        /// @brief Default constructor, zero
+        constexpr IniFixed() = default;
+
+        /**
+         * @brief Creates a value from its scaled integer representation
+         * @param raw The scaled integer, e.g. 3140 for 3.14 with 3 decimals
+         * @return IniFixed The value
+         */
+        static constexpr IniFixed fromRaw(long long raw) {
+            IniFixed result;
+            result.scaled = raw;
+            return result;
+        }
+
+        /**
+         * @brief Returns the scaled integer representation
+         * @return long long The scaled integer, e.g. 3140 for 3.14 with 3 decimals
+         */
+        constexpr long long raw() const { return scaled; }
+
+        /**
+         * @brief Converts the value to floating point
+         * @return double The nearest double
+         */
+        constexpr double toDouble() const { return static_cast<double>(scaled) / static_cast<double>(scale); }
+
+        constexpr bool operator==(const IniFixed& other) const { return scaled == other.scaled; }
+        constexpr bool operator!=(const IniFixed& other) const { return scaled != other.scaled; }
+        constexpr bool operator<(const IniFixed& other) const { return scaled < other.scaled; }
+        constexpr bool operator<=(const IniFixed& other) const { return scaled <= other.scaled; }
+        constexpr bool operator>(const IniFixed& other) const { return scaled > other.scaled; }
+        constexpr bool operator>=(const IniFixed& other) const { return scaled >= other.scaled; }
+
+    private:
+        long long scaled = 0; ///< The value multiplied by scale
+    };
+
+    /**
+     * @brief Parses a decimal number into a scaled integer, without floating point, allocation or exceptions.
+     *
+     * Accepts an optional sign, integer digits and an optional fraction. Digits beyond
+     * the kept decimals are rounded half away from zero.
+     *
+     * @tparam Decimals Number of decimal digits kept after the point.
+     * @param value The text to parse.
+     * @param result Receives the parsed value, untouched on failure.
+     * @return true if the whole text is a decimal number representable by IniFixed<Decimals>, false otherwise.
+     */
+    template<unsigned Decimals>
+    constexpr bool parseFixed(std::string_view value, IniFixed<Decimals>& result) {
+        constexpr unsigned long long limit = static_cast<unsigned long long>(std::numeric_limits<long long>::max());
+        bool negative = false;
+        size_t i = 0;
+        if (i < value.size() && (value[i] == '-' || value[i] == '+')) {
+            negative = value[i] == '-';
+            ++i;
+        }
+
+        unsigned long long magnitude = 0;
+        size_t digits = 0;
+        for (; i < value.size() && value[i] >= '0' && value[i] <= '9'; ++i, ++digits) {
+            if (magnitude > (limit - (value[i] - '0')) / 10) return false;
+            magnitude = magnitude * 10 + (value[i] - '0');
+        }
+
+        unsigned decimals = 0;
+        bool roundUp = false;
+        if (i < value.size() && value[i] == '.') {
+            for (++i; i < value.size() && value[i] >= '0' && value[i] <= '9'; ++i, ++digits) {
+                if (decimals < Decimals) {
+                    if (magnitude > (limit - (value[i] - '0')) / 10) return false;
+                    magnitude = magnitude * 10 + (value[i] - '0');
+                    ++decimals;
+                }
+                else if (decimals == Decimals) {
+                    roundUp = value[i] >= '5';
+                    ++decimals;
+                }
+            }
+        }
+        if (digits == 0 || i != value.size()) return false;
+
+        for (; decimals < Decimals; ++decimals) {
+            if (magnitude > limit / 10) return false;
+            magnitude *= 10;
+        }
+        if (roundUp) {
+            if (magnitude == limit) return false;
+            ++magnitude;
+        }
+
+        long long scaled = static_cast<long long>(magnitude);
+        result = IniFixed<Decimals>::fromRaw(negative ? -scaled : scaled);
+        return true;
+    }
+
+    /**
+     * @class IniValueConvert
+     * @brief Specialization for exact decimal numbers.
+     */
+    template<unsigned Decimals>
+    class IniValueConvert<IniFixed<Decimals>> {
+    public:
+        /**
+         * @brief Decodes a string into a fixed-point decimal, without floating point.
+         * @param value The string to decode.
+         * @return IniFixed<Decimals> The decoded value.
+         * @throws IniValueConvertException if the value is not a decimal number or is out of range.
+         */
+        static IniFixed<Decimals> decode(const std::string& value) {
+            IniFixed<Decimals> result;
+            if (!parseFixed(value, result)) {
+                throw IniValueConvertException("Invalid fixed-point value: " + value);
+            }
+            return result;
+        }
+
+        /**
+         * @brief Decodes a string into a fixed-point decimal, without throwing.
+         * @param value The string to decode.
+         * @param result Receives the decoded value.
+         * @return true if the conversion succeeded, false otherwise.
+         */
+        static bool tryDecode(std::string_view value, IniFixed<Decimals>& result) {
+            return parseFixed(value, result);
+        }
+
+        /**
+         * @brief Encodes a fixed-point decimal into a string, exactly.
+         *
+         * Trailing zeros of the fraction are omitted, so 3140 with 3 decimals encodes as "3.14".
+         *
+         * @param value The value to encode.
+         * @return std::string The encoded string.
+         */
+        static std::string encode(const IniFixed<Decimals>& value) {
+            long long raw = value.raw();
+            unsigned long long magnitude = raw < 0 ? 0ull - static_cast<unsigned long long>(raw) : static_cast<unsigned long long>(raw);
+            unsigned long long scale = static_cast<unsigned long long>(IniFixed<Decimals>::scale);
+
+            std::string result = raw < 0 ? "-" : "";
+            result += std::to_string(magnitude / scale);
+            unsigned long long fraction = magnitude % scale;
+            if (fraction != 0) {
+                char digits[Decimals + 1] = {};
+                for (unsigned i = Decimals; i > 0; --i) {
+                    digits[i - 1] = static_cast<char>('0' + fraction % 10);
+                    fraction /= 10;
+                }
+                size_t length = Decimals;
+                while (digits[length - 1] == '0') --length;
+                result += '.';
+                result.append(digits, length);
+            }
+            return result;
+        }
+    };
+
+    /// @brief Fixed-point values round trip exactly, so IniValue may keep them in native form
+    template<unsigned Decimals>
+    struct IniNativeStorable<IniFixed<Decimals>> : std::true_type {};
+
+} // namespace IniLib
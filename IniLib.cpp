@@ -23,75 +23,419 @@ SOFTWARE.
 */
 
 #include "IniLib.h"
+#include "IniSchema.h"
 #include <sstream>
 #include <fstream>
 #include <algorithm>
 #include <cctype>
+#include <cstdio>
+#include <filesystem>
+#include <mutex>
+#include <atomic>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace IniLib {
 
+    namespace {
+
+        /**
+         * @brief Flushes a written file to disk
+         * @param path The path of the file
+         * @return true if the file was flushed, false otherwise
+         */
+        bool syncFile(const std::string& path) {
+#ifdef _WIN32
+            HANDLE handle = CreateFileA(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (handle == INVALID_HANDLE_VALUE) return false;
+            bool synced = FlushFileBuffers(handle) != 0;
+            CloseHandle(handle);
+            return synced;
+#else
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) return false;
+            bool synced = ::fsync(fd) == 0;
+            ::close(fd);
+            return synced;
+#endif
+        }
+
+        /**
+         * @brief Returns a temporary path next to a file, unique to this process and call
+         * @param path The path of the file
+         * @return std::string The temporary path
+         */
+        std::string tempPath(const std::string& path) {
+            static std::atomic<unsigned long> counter{ 0 };
+#ifdef _WIN32
+            unsigned long process = GetCurrentProcessId();
+#else
+            unsigned long process = static_cast<unsigned long>(::getpid());
+#endif
+            return path + "." + std::to_string(process) + "." + std::to_string(counter++) + ".tmp";
+        }
+
+        /**
+         * @brief Renames a file over another, replacing it atomically
+         *
+         * The renamed file first gets the permissions of the file it replaces, since it was
+         * created with the default ones.
+         *
+         * @param from The path of the file to rename
+         * @param to The path to rename it to
+         * @return true if the file was renamed, false otherwise
+         */
+        bool replaceFile(const std::string& from, const std::string& to) {
+            std::error_code error;
+            std::filesystem::file_status target = std::filesystem::status(to, error);
+            if (!error && std::filesystem::exists(target)) {
+                std::filesystem::permissions(from, target.permissions(), error);
+                if (error) return false;
+            }
+#ifdef _WIN32
+            return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+            return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+        }
+
+        /**
+         * @brief Appends a journal record field, escaping the characters that delimit records
+         * @param out The record being built
+         * @param field The section, key or value
+         */
+        void appendEscaped(std::string& out, std::string_view field) {
+            for (char c : field) {
+                switch (c) {
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\t': out += "\\t"; break;
+                default: out += c; break;
+                }
+            }
+        }
+
+        /**
+         * @brief Restores a journal record field written by appendEscaped
+         * @param field The escaped field
+         * @return std::string The original field
+         */
+        std::string unescape(std::string_view field) {
+            std::string out;
+            out.reserve(field.size());
+            for (size_t i = 0; i < field.size(); ++i) {
+                if (field[i] != '\\' || i + 1 == field.size()) {
+                    out += field[i];
+                    continue;
+                }
+                char c = field[++i];
+                out += (c == 'n') ? '\n' : (c == 't') ? '\t' : c;
+            }
+            return out;
+        }
+
+        /**
+         * @brief Flushes a directory entry list to disk, making renames inside it durable
+         * @param path The path of the directory
+         * @return true if the directory was flushed, false otherwise
+         */
+        bool syncDirectory(const std::string& path) {
+#ifdef _WIN32
+            // MOVEFILE_WRITE_THROUGH already flushed the rename
+            (void)path;
+            return true;
+#else
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) return false;
+            bool synced = ::fsync(fd) == 0;
+            ::close(fd);
+            return synced;
+#endif
+        }
+
+        /**
+         * @brief Replaces a file atomically with the given bytes, written as is
+         * @param path The path of the file
+         * @param contents The new contents
+         * @return true if the file was replaced and the rename flushed, false otherwise
+         */
+        bool writeAtomic(const std::string& path, std::string_view contents) {
+            std::string temp = tempPath(path);
+            std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+            file.write(contents.data(), contents.size());
+            file.close();
+            if (file.fail() || !syncFile(temp) || !replaceFile(temp, path)) {
+                std::remove(temp.c_str());
+                return false;
+            }
+            std::string directory = std::filesystem::path(path).parent_path().string();
+            return syncDirectory(directory.empty() ? "." : directory);
+        }
+
+    } // namespace
+
     //IniValue class methods
+    void IniValue::encodeText() const {
+        // Encoding happens once per value, so a single lock is rarely contended
+        static std::mutex encodeMutex;
+        std::lock_guard<std::mutex> lock(encodeMutex);
+        if (!textValid.load(std::memory_order_relaxed)) {
+            nativeOps->encode(native, values);
+            textValid.store(true, std::memory_order_release);
+        }
+    }
+
     std::string IniValue::getString() const {
-        if (values.empty()) {
+        const std::vector<std::string>& elements = text();
+        if (elements.empty()) {
             return "";
         }
-        else if (values.size() == 1) {
-            return values[0];
+        else if (elements.size() == 1) {
+            return elements[0];
         }
         else {
-            return join(values, ", ");
+            std::string result;
+            result.reserve(stringLength());
+            appendString(result);
+            return result;
+        }
+    }
+
+    std::string_view IniValue::getView(size_t index) const {
+        const std::vector<std::string>& elements = text();
+        if (index >= elements.size()) {
+            throw IniFileException("Index out of bounds");
+        }
+        return elements[index];
+    }
+
+    size_t IniValue::stringLength() const {
+        const std::vector<std::string>& elements = text();
+        if (elements.empty()) {
+            return 0;
+        }
+        size_t length = (elements.size() - 1) * 2; // ", " between elements
+        for (const std::string& value : elements) {
+            length += value.size();
+        }
+        return length;
+    }
+
+    void IniValue::appendString(std::string& out) const {
+        const std::vector<std::string>& elements = text();
+        for (size_t i = 0; i < elements.size(); ++i) {
+            if (i != 0) out.append(", ", 2);
+            out.append(elements[i]);
+        }
+    }
+
+    DecodeResult IniValue::decodeBitsInto(std::uint64_t* words, size_t n) const {
+        const bool* data;
+        size_t count;
+        if (nativeElements(data, count)) {
+            count = std::min(n, count);
+            for (size_t i = 0; i < count; ++i) {
+                if (i % 64 == 0) words[i / 64] = 0;
+                words[i / 64] |= std::uint64_t(data[i]) << (i % 64);
+            }
+            return DecodeResult{ count, true };
+        }
+
+        // Accumulate each word in a register and store it once it is full
+        const std::vector<std::string>& elements = text();
+        count = std::min(n, elements.size());
+        std::uint64_t word = 0;
+        for (size_t i = 0; i < count; ++i) {
+            bool flag;
+            if (!parseBool(elements[i], flag)) {
+                if (i % 64 != 0) words[i / 64] = word;
+                return DecodeResult{ i, false };
+            }
+            word |= std::uint64_t(flag) << (i % 64);
+            if (i % 64 == 63) {
+                words[i / 64] = word;
+                word = 0;
+            }
         }
+        if (count % 64 != 0) words[count / 64] = word;
+        return DecodeResult{ count, true };
     }
 
     void IniValue::append(const std::string& value) {
+        detachNative();
         values.push_back(value);
+        modified();
     }
 
     void IniValue::clear() {
+        resetNative();
         values.clear();
+        modified();
     }
 
     std::string& IniValue::operator[](size_t index) {
+        detachNative();
         if (index >= values.size()) {
             throw IniFileException("Index out of bounds");
         }
+        modified();
         return values[index];
     }
 
+    void IniValue::modified() {
+        if (owner) owner->markDirty(*ownerKey);
+    }
+
     const std::string& IniValue::operator[](size_t index) const {
-        if (index >= values.size()) {
+        const std::vector<std::string>& elements = text();
+        if (index >= elements.size()) {
             throw IniFileException("Index out of bounds");
         }
-        return values[index];
+        return elements[index];
     }
 
-    std::string IniValue::join(const std::vector<std::string>& vec, const std::string& delimiter) {
-        std::ostringstream oss;
-        for (size_t i = 0; i < vec.size(); ++i) {
-            if (i != 0) oss << delimiter;
-            oss << vec[i];
+    // IniQuery class methods
+    IniQuery::IniQuery(std::initializer_list<std::pair<std::string_view, std::string_view>> entries) {
+        for (const auto& entry : entries) {
+            add(entry.first, entry.second);
         }
-        return oss.str();
+    }
+
+    size_t IniQuery::add(std::string_view section, std::string_view key) {
+        size_t sectionHash = hashKey(section);
+        auto group = std::find_if(groups.begin(), groups.end(), [&](const SectionGroup& g) {
+            return g.hash == sectionHash && keyEquals(section, g.name);
+        });
+        if (group == groups.end()) {
+            group = groups.insert(groups.end(), SectionGroup{ std::string(section), sectionHash, {} });
+        }
+        group->keys.push_back(KeyEntry{ std::string(key), hashKey(key), count });
+        return count++;
     }
 
     // IniSection class methods
+    IniSection::IniSection(const IniSection& other)
+        : keyValues(other.keyValues), dirtyKeys(other.dirtyKeys), dirty(other.dirty),
+          journalKeys(other.journalKeys), journalQueued(other.journalQueued) {
+        adoptAll();
+    }
+
+    IniSection::IniSection(IniSection&& other)
+        : keyValues(std::move(other.keyValues)), dirtyKeys(std::move(other.dirtyKeys)), dirty(other.dirty),
+          journalKeys(std::move(other.journalKeys)), journalQueued(other.journalQueued) {
+        adoptAll();
+    }
+
+    IniSection& IniSection::operator=(const IniSection& other) {
+        if (this != &other) *this = IniSection(other);
+        return *this;
+    }
+
+    IniSection& IniSection::operator=(IniSection&& other) {
+        if (this != &other) {
+            for (const auto& kv : keyValues) markDirty(kv.first);
+            keyValues = std::move(other.keyValues);
+            other.keyValues.clear();
+            adoptAll();
+            for (const auto& kv : keyValues) markDirty(kv.first);
+        }
+        return *this;
+    }
+
     IniValue IniSection::get(const std::string& key, const IniValue& defaultValue) const {
         auto it = keyValues.find(IniFile::toLower(key));
         return (it != keyValues.end()) ? it->second : defaultValue;
     }
 
+    const IniValue& IniSection::getRef(const std::string& key, const IniValue& defaultValue) const {
+        const IniValue* value = find(key);
+        return value ? *value : defaultValue;
+    }
+
+    IniValue* IniSection::find(const std::string& key) {
+        auto it = keyValues.find(IniFile::toLower(key));
+        return (it != keyValues.end()) ? &it->second : nullptr;
+    }
+
+    const IniValue* IniSection::find(const std::string& key) const {
+        auto it = keyValues.find(IniFile::toLower(key));
+        return (it != keyValues.end()) ? &it->second : nullptr;
+    }
+
+    IniValue* IniSection::find(const IniKey& key) {
+        auto it = keyValues.find(key);
+        return (it != keyValues.end()) ? &it->second : nullptr;
+    }
+
+    const IniValue* IniSection::find(const IniKey& key) const {
+        auto it = keyValues.find(key);
+        return (it != keyValues.end()) ? &it->second : nullptr;
+    }
+
     void IniSection::set(const std::string& key, const IniValue& value) {
-        keyValues[IniFile::toLower(key)] = value;
+        auto result = keyValues.try_emplace(IniFile::toLower(key), value);
+        if (result.second) {
+            adopt(*result.first);
+            markDirty(result.first->first);
+        }
+        else {
+            result.first->second = value;
+        }
+    }
+
+    void IniSection::set(const std::string& key, IniValue&& value) {
+        auto result = keyValues.try_emplace(IniFile::toLower(key), std::move(value));
+        if (result.second) {
+            adopt(*result.first);
+            markDirty(result.first->first);
+        }
+        else {
+            result.first->second = std::move(value);
+        }
     }
 
     bool IniSection::removeKey(const std::string& key) {
-        return keyValues.erase(IniFile::toLower(key)) > 0;
+        std::string lowerKey = IniFile::toLower(key);
+        if (keyValues.erase(lowerKey) == 0) return false;
+        markDirty(lowerKey);
+        return true;
     }
 
     void IniSection::clear() {
+        for (const auto& kv : keyValues) {
+            markDirty(kv.first);
+        }
+        dirty = true;
         keyValues.clear();
     }
 
+    void IniSection::markDirty(const std::string& key) {
+        dirty = true;
+        dirtyKeys.insert(key);
+        if (file != nullptr && file->journalEnabled) {
+            journalKeys.insert(key);
+            if (!journalQueued) {
+                file->journalSections.push_back(*name);
+                journalQueued = true;
+            }
+        }
+    }
+
+    bool IniSection::isDirty(const std::string& key) const {
+        return dirtyKeys.find(IniFile::toLower(key)) != dirtyKeys.end();
+    }
+
     bool IniSection::hasKey(const std::string& key) const {
         return keyValues.find(IniFile::toLower(key)) != keyValues.end();
     }
@@ -101,7 +445,12 @@ namespace IniLib {
     }
 
     IniValue& IniSection::operator[](const std::string& key) {
-        return keyValues[IniFile::toLower(key)];
+        auto result = keyValues.try_emplace(IniFile::toLower(key));
+        if (result.second) {
+            adopt(*result.first);
+            markDirty(result.first->first);
+        }
+        return result.first->second;
     }
 
     const IniValue& IniSection::operator[](const std::string& key) const {
@@ -112,74 +461,860 @@ namespace IniLib {
         return it->second;
     }
 
+    IniValue& IniSection::operator[](const IniKey& key) {
+        auto it = keyValues.find(key);
+        if (it == keyValues.end()) {
+            it = keyValues.try_emplace(IniFile::toLower(std::string(key.name()))).first;
+            adopt(*it);
+            markDirty(it->first);
+        }
+        return it->second;
+    }
+
+    const IniValue& IniSection::operator[](const IniKey& key) const {
+        auto it = keyValues.find(key);
+        if (it == keyValues.end()) {
+            throw IniFileException("Key \"" + std::string(key.name()) + "\" does not exist in the section.");
+        }
+        return it->second;
+    }
+
     // IniFile class methods
+    IniFile::IniFile(const IniFile& other)
+        : sections(other.sections), sourcePath(other.sourcePath), sourceText(other.sourceText), sourceSpans(other.sourceSpans),
+          sourceCrlf(other.sourceCrlf), removedSections(other.removedSections), trackChanges(other.trackChanges),
+          preserveFormat(other.preserveFormat), sortedOutput(other.sortedOutput), journalEnabled(other.journalEnabled), journalThreshold(other.journalThreshold),
+          journalSize(other.journalSize), journalRemovedSections(other.journalRemovedSections), journalSections(other.journalSections) {
+        adoptSections();
+    }
+
+    IniFile::IniFile(IniFile&& other) {
+        *this = std::move(other);
+    }
+
+    IniFile& IniFile::operator=(const IniFile& other) {
+        if (this != &other) *this = IniFile(other);
+        return *this;
+    }
+
+    IniFile& IniFile::operator=(IniFile&& other) {
+        if (this != &other) {
+            sections = std::move(other.sections);
+            sourcePath = std::move(other.sourcePath);
+            sourceText = std::move(other.sourceText);
+            sourceSpans = std::move(other.sourceSpans);
+            sourceCrlf = other.sourceCrlf;
+            removedSections = std::move(other.removedSections);
+            trackChanges = other.trackChanges;
+            preserveFormat = other.preserveFormat;
+            sortedOutput = other.sortedOutput;
+            journalEnabled = other.journalEnabled;
+            journalThreshold = other.journalThreshold;
+            journalSize = other.journalSize;
+            journalRemovedSections = std::move(other.journalRemovedSections);
+            journalSections = std::move(other.journalSections);
+            adoptSections();
+        }
+        return *this;
+    }
+
+    std::pair<IniFile::SectionMap::iterator, bool> IniFile::insertSection(std::string name) {
+        auto result = sections.try_emplace(std::move(name));
+        if (result.second) {
+            result.first->second.file = this;
+            result.first->second.name = &result.first->first;
+        }
+        return result;
+    }
+
+    void IniFile::adoptSections() {
+        for (auto& sectionPair : sections) {
+            sectionPair.second.file = this;
+            sectionPair.second.name = &sectionPair.first;
+        }
+    }
+
     bool IniFile::load(const std::string& filename) {
-        std::ifstream file(filename);
+        return load(filename, nullptr);
+    }
+
+    bool IniFile::load(const std::string& filename, const IniSchema& schema, std::vector<IniSchemaViolation>& violations) {
+        IniSchemaValidator validator(schema, violations);
+        return load(filename, &validator);
+    }
+
+    bool IniFile::load(const std::string& filename, IniSchemaValidator* validator) {
+        std::ifstream file(filename, std::ios::binary);
         if (!file.is_open()) return false;
 
-        std::string line, currentSection;
-        while (std::getline(file, line)) {
-            line = trim(removeComment(line));
-            if (line.empty()) continue;
+        std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        bool crlf = false;
+        std::vector<SourceSpan> spans = scanSource(text, crlf);
+        // Sections merged into existing ones don't match any single file
+        bool tracked = sections.empty() && tracksSource();
+
+        for (const SourceSpan& span : spans) {
+            if (span.entries.empty()) continue; // Headers alone don't create sections
+            if (validator) validator->beginSection(span.section);
 
-            if (line.front() == '[' && line.back() == ']') {
-                currentSection = toLower(trim(line.substr(1, line.size() - 2)));
+            IniSection& section = insertSection(span.section).first->second;
+            for (const EntrySpan& entry : span.entries) {
+                std::string key = toLower(text.substr(entry.keyBegin, entry.keyEnd - entry.keyBegin));
+                IniValue parsed(split(text.substr(entry.valueBegin, entry.valueEnd - entry.valueBegin), ','));
+                // Keys are already lowercased, so move straight into the map
+                auto result = section.keyValues.try_emplace(std::move(key), std::move(parsed));
+                if (result.second) section.adopt(*result.first);
+                else result.first->second = std::move(parsed);
+                // The stored value is checked, so a repeated key is validated with its last value, as validate does
+                if (validator) validator->validateKey(result.first->first, result.first->second);
             }
-            else {
-                auto pos = line.find('=');
-                if (pos != std::string::npos) {
-                    std::string key = toLower(trim(line.substr(0, pos)));
-                    std::string value = trim(line.substr(pos + 1));
-                    std::vector<std::string> values = split(value, ',');
-                    sections[currentSection].set(key, values);
+        }
+        if (validator) validator->finish();
+
+        // Keep the text only when saveChanges, preserved saves or the journal reuse it
+        if (tracked) {
+            sourcePath = filename;
+            sourceText = std::move(text);
+            sourceSpans = std::move(spans);
+            sourceCrlf = crlf;
+            markClean();
+            if (journalEnabled) replayJournal();
+        }
+        else {
+            sourcePath.clear();
+            sourceText.clear();
+            sourceSpans.clear();
+        }
+        return true;
+    }
+
+    void IniFile::setJournal(bool enabled, size_t compactThreshold) {
+        journalEnabled = enabled;
+        journalThreshold = compactThreshold;
+        clearJournalQueue();
+    }
+
+    void IniFile::replayJournal() {
+        std::ifstream file(journalPath(), std::ios::binary);
+        std::string text;
+        if (file.is_open()) {
+            text.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+        journalSize = text.size();
+
+        // One record per line: "=section\tkey\tvalue", "-section\tkey" or "!section", with
+        // backslashes, newlines and tabs in the fields escaped as "\\\\", "\\n" and "\\t".
+        // A last line without newline was cut short by a crash and is ignored.
+        // Sections are changed directly, since the IniFile methods would journal the records again.
+        for (size_t lineStart = 0; lineStart < text.size();) {
+            size_t lineEnd = text.find('\n', lineStart);
+            if (lineEnd == std::string::npos) break;
+            std::string_view record(text.data() + lineStart + 1, lineEnd - lineStart - 1);
+            char type = text[lineStart];
+            lineStart = lineEnd + 1;
+
+            size_t sectionEnd = record.find('\t');
+            std::string section = toLower(unescape(record.substr(0, sectionEnd)));
+            if (type == '!') {
+                if (sections.erase(section) > 0) removedSections.insert(std::move(section));
+                continue;
+            }
+            if (sectionEnd == std::string_view::npos) continue;
+
+            std::string_view rest = record.substr(sectionEnd + 1);
+            size_t keyEnd = rest.find('\t');
+            std::string key = unescape(rest.substr(0, keyEnd));
+            if (type == '-') {
+                auto secIt = sections.find(section);
+                if (secIt != sections.end()) secIt->second.removeKey(key);
+            }
+            else if (type == '=' && keyEnd != std::string_view::npos) {
+                insertSection(std::move(section)).first->second.set(key, IniValue(split(unescape(rest.substr(keyEnd + 1)), ',')));
+            }
+        }
+
+        // The replayed changes are on disk in the journal, but not yet in the file
+        clearJournalQueue();
+    }
+
+    void IniFile::clearJournalQueue() {
+        for (const std::string& name : journalSections) {
+            auto secIt = sections.find(name);
+            if (secIt != sections.end()) {
+                secIt->second.journalKeys.clear();
+                secIt->second.journalQueued = false;
+            }
+        }
+        journalSections.clear();
+        journalRemovedSections.clear();
+    }
+
+    bool IniFile::appendJournal() {
+        if (!journalEnabled || sourcePath.empty()) return false;
+
+        // Removals come first, so sections created again afterwards are replayed in order
+        std::string records;
+        for (const std::string& section : journalRemovedSections) {
+            records += '!';
+            appendEscaped(records, section);
+            records += '\n';
+        }
+        // Only the sections queued by their modifications are visited
+        for (const std::string& name : journalSections) {
+            auto secIt = sections.find(name);
+            if (secIt == sections.end()) continue;
+            const IniSection& section = secIt->second;
+            for (const std::string& key : section.journalKeys) {
+                auto keyIt = section.keyValues.find(key);
+                records += (keyIt == section.keyValues.end()) ? '-' : '=';
+                appendEscaped(records, name);
+                records += '\t';
+                appendEscaped(records, key);
+                if (keyIt != section.keyValues.end()) {
+                    records += '\t';
+                    appendEscaped(records, keyIt->second.getString());
                 }
+                records += '\n';
             }
         }
+        if (records.empty()) return true;
+
+        std::ofstream file(journalPath(), std::ios::binary | std::ios::app);
+        if (!file.is_open()) return false;
+        file.write(records.data(), records.size());
+        file.close();
+        if (file.fail()) return false;
+
+        clearJournalQueue();
+        journalSize += records.size();
+
+        return journalSize <= journalThreshold || compactJournal();
+    }
+
+    bool IniFile::compactJournal() {
+        if (sourcePath.empty()) return false;
+
+        // Render once and replace the file atomically with those bytes, so a crash leaves
+        // either the old file and its journal or the new file, and the kept text matches the disk
+        std::string text;
+        renderPreserved(text);
+        if (!writeAtomic(sourcePath, text)) return false;
+
+        // Only a durable removal makes the journal's records obsolete
+        std::error_code error;
+        std::filesystem::remove(journalPath(), error);
+        if (error) return false;
+        std::string directory = std::filesystem::path(sourcePath).parent_path().string();
+        if (!syncDirectory(directory.empty() ? "." : directory)) return false;
+        journalSize = 0;
+
+        sourceSpans = scanSource(text, sourceCrlf);
+        sourceText = std::move(text);
+        markClean();
         return true;
     }
 
-    bool IniFile::save(const std::string& filename) const {
-        std::ofstream file(filename);
+    bool IniFile::save(const std::string& filename, unsigned threads) const {
+        std::vector<std::string> buffers = render(threads);
+
+        // Preserved text keeps its original line endings
+        std::ofstream file(filename, rendersPreserved() ? std::ios::out | std::ios::binary : std::ios::out);
         if (!file.is_open()) return false;
+        for (const std::string& buffer : buffers) {
+            file.write(buffer.data(), buffer.size());
+        }
+        return file.good();
+    }
 
-        for (const auto& sectionPair : sections) {
-            file << "[" << sectionPair.first << "]\n";
-            const IniSection::KeyValueMap& keyValues = sectionPair.second.keyValues;
-            for (const auto& kv : keyValues) {
-                file << kv.first << "=" << kv.second.getString() << "\n";
+    void IniFile::saveToBuffer(std::string& out) const {
+        if (rendersPreserved()) {
+            renderPreserved(out);
+        }
+        else {
+            out.reserve(out.size() + serializedLength());
+            serialize(out);
+        }
+    }
+
+    std::string IniFile::saveToString() const {
+        std::string out;
+        saveToBuffer(out);
+        return out;
+    }
+
+    bool IniFile::saveToStream(std::ostream& out, unsigned threads) const {
+        for (const std::string& buffer : render(threads)) {
+            out.write(buffer.data(), buffer.size());
+        }
+        return out.good();
+    }
+
+    void IniFile::saveToSink(const std::function<void(std::string_view chunk)>& sink) const {
+        if (rendersPreserved()) {
+            std::string buffer;
+            renderPreserved(buffer);
+            sink(buffer);
+            return;
+        }
+
+        std::string buffer;
+        for (const SectionMap::value_type* sectionPair : orderedSections()) {
+            buffer.clear();
+            serializeSection(sectionPair->first, sectionPair->second, buffer, true, sortedOutput);
+            sink(buffer);
+        }
+    }
+
+    std::vector<std::string> IniFile::render(unsigned threads) const {
+        if (!rendersPreserved() && threads >= 2 && sections.size() >= threads) {
+            return serializeParallel(threads);
+        }
+        std::vector<std::string> buffers(1);
+        saveToBuffer(buffers[0]);
+        return buffers;
+    }
+
+    bool IniFile::saveAtomic(const std::string& filename) const {
+        return saveAll({ { filename, this } });
+    }
+
+    bool IniFile::saveAll(const std::vector<std::pair<std::string, const IniFile*>>& files) {
+        if (files.empty()) return true;
+
+        // Each file is written and flushed on its own thread, so the flushes overlap
+        constexpr size_t maxThreads = 64;
+        std::vector<std::string> tempNames(files.size());
+        std::vector<char> written(files.size(), 0);
+        auto removeTemps = [&] {
+            for (const std::string& tempName : tempNames) {
+                if (!tempName.empty()) std::remove(tempName.c_str());
             }
-            file << "\n";
+        };
+        try {
+            runParallel(files.size(), static_cast<unsigned>(std::min(files.size(), maxThreads)), [&](size_t first, size_t last) {
+                for (size_t i = first; i < last; ++i) {
+                    tempNames[i] = tempPath(files[i].first);
+                    written[i] = files[i].second->save(tempNames[i]) && syncFile(tempNames[i]);
+                }
+            });
+        }
+        catch (...) {
+            removeTemps();
+            throw;
+        }
+
+        bool success = std::all_of(written.begin(), written.end(), [](char flushed) { return flushed != 0; });
+        if (!success) {
+            removeTemps();
+            return false;
+        }
+
+        std::vector<std::string> directories;
+        for (size_t i = 0; i < files.size(); ++i) {
+            if (!replaceFile(tempNames[i], files[i].first)) {
+                std::remove(tempNames[i].c_str());
+                success = false;
+                continue;
+            }
+            std::string directory = std::filesystem::path(files[i].first).parent_path().string();
+            if (directory.empty()) directory = ".";
+            if (std::find(directories.begin(), directories.end(), directory) == directories.end()) {
+                directories.push_back(std::move(directory));
+            }
+        }
+
+        // Flush each directory once, after all of its renames
+        for (const std::string& directory : directories) {
+            success = syncDirectory(directory) && success;
+        }
+        return success;
+    }
+
+    bool IniFile::saveChanges(const std::string& filename) {
+        if (filename == sourcePath && !isDirty()) return true;
+
+        std::string buffer;
+        size_t unchanged = 0; // Leading bytes already on disk
+
+        if (sourcePath.empty()) {
+            buffer.reserve(serializedLength());
+            serialize(buffer);
+        }
+        else {
+            renderPreserved(buffer);
+            if (filename == sourcePath) {
+                unchanged = std::mismatch(buffer.begin(), buffer.begin() + std::min(buffer.size(), sourceText.size()), sourceText.begin()).first - buffer.begin();
+            }
+        }
+
+        if (!sourcePath.empty() && filename == sourcePath && buffer.size() == sourceText.size()) {
+            // Same length: overwrite only the byte ranges that differ, in place
+            std::fstream file;
+            for (size_t begin = unchanged; begin < buffer.size();) {
+                // A range ends at the first run of equal bytes too long to be worth another seek
+                constexpr size_t patchGap = 64;
+                size_t end = begin, equal = 0;
+                while (end + equal < buffer.size() && equal < patchGap) {
+                    if (buffer[end + equal] == sourceText[end + equal]) {
+                        ++equal;
+                    }
+                    else {
+                        end += equal + 1;
+                        equal = 0;
+                    }
+                }
+
+                if (!file.is_open()) {
+                    file.open(filename, std::ios::binary | std::ios::in | std::ios::out);
+                    if (!file.is_open()) return false;
+                }
+                file.seekp(begin);
+                file.write(buffer.data() + begin, end - begin);
+                begin = std::mismatch(buffer.begin() + end, buffer.end(), sourceText.begin() + end).first - buffer.begin();
+            }
+            if (file.is_open()) {
+                file.close();
+                if (file.fail()) return false;
+            }
+        }
+        else if (unchanged == 0) {
+            std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) return false;
+            file.write(buffer.data(), buffer.size());
+            if (!file.good()) return false;
+        }
+        else {
+            // Rewrite from the first modified byte, then drop any leftover tail
+            std::fstream file(filename, std::ios::binary | std::ios::in | std::ios::out);
+            if (!file.is_open()) return false;
+            file.seekp(unchanged);
+            file.write(buffer.data() + unchanged, buffer.size() - unchanged);
+            file.close();
+            if (file.fail()) return false;
+            if (buffer.size() < sourceText.size()) {
+                std::error_code error;
+                std::filesystem::resize_file(filename, buffer.size(), error);
+                if (error) return false;
+            }
+        }
+
+        if (tracksSource()) {
+            sourcePath = filename;
+            sourceSpans = scanSource(buffer, sourceCrlf);
+            sourceText = std::move(buffer);
+        }
+        markClean();
+
+        // The file now holds every journaled change
+        if (journalEnabled) {
+            std::remove(journalPath().c_str());
+            journalSize = 0;
         }
         return true;
     }
 
+    std::vector<IniFile::SourceSpan> IniFile::scanSource(const std::string& text, bool& crlf) {
+        auto isBlank = [](char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; };
+
+        // The first line decides the line ending of lines added when rendering
+        size_t firstNewline = text.find('\n');
+        crlf = firstNewline != std::string::npos && firstNewline > 0 && text[firstNewline - 1] == '\r';
+
+        std::vector<SourceSpan> spans;
+        spans.push_back(SourceSpan{ "", 0, 0, false, {} });
+        for (size_t lineStart = 0; lineStart < text.size();) {
+            size_t lineEnd = text.find('\n', lineStart);
+            size_t next = (lineEnd == std::string::npos) ? text.size() : lineEnd + 1;
+            if (lineEnd == std::string::npos) lineEnd = text.size();
+
+            // Content stops at the first comment character, without surrounding whitespace
+            std::string_view line(text.data() + lineStart, lineEnd - lineStart);
+            size_t first = lineStart;
+            size_t last = lineStart + std::min(line.find_first_of(";#"), line.size());
+            while (first < last && isBlank(text[first])) ++first;
+            while (last > first && isBlank(text[last - 1])) --last;
+
+            if (first < last && text[first] == '[' && text[last - 1] == ']' && last - first >= 2) {
+                spans.back().end = lineStart;
+                spans.push_back(SourceSpan{ toLower(trim(text.substr(first + 1, last - first - 2))), lineStart, 0, true, {} });
+            }
+            else if (first < last) {
+                size_t equals = text.find('=', first);
+                if (equals < last) {
+                    EntrySpan entry{ lineStart, next, first, equals, equals + 1, last };
+                    while (entry.keyEnd > entry.keyBegin && isBlank(text[entry.keyEnd - 1])) --entry.keyEnd;
+                    while (entry.valueBegin < entry.valueEnd && isBlank(text[entry.valueBegin])) ++entry.valueBegin;
+                    spans.back().entries.push_back(entry);
+                }
+            }
+            lineStart = next;
+        }
+        spans.back().end = text.size();
+        if (spans.front().end == 0) spans.erase(spans.begin());
+        return spans;
+    }
+
+    void IniFile::renderPreserved(std::string& out) const {
+        out.reserve(out.size() + sourceText.size());
+        // Added lines end like the loaded ones
+        const char* newline = sourceCrlf ? "\r\n" : "\n";
+
+        // Verbatim regions are collected into one run, appended when something else is written
+        size_t runBegin = 0, runEnd = 0;
+        auto copy = [&](size_t begin, size_t end) {
+            if (begin == end) return;
+            if (begin != runEnd) {
+                out.append(sourceText, runBegin, runEnd - runBegin);
+                runBegin = begin;
+            }
+            runEnd = end;
+        };
+        auto flush = [&] {
+            out.append(sourceText, runBegin, runEnd - runBegin);
+            runBegin = runEnd;
+        };
+        auto keyOf = [&](const EntrySpan& entry) {
+            return toLower(sourceText.substr(entry.keyBegin, entry.keyEnd - entry.keyBegin));
+        };
+        // Whether a value still holds what its line says, split and trimmed as load does
+        auto sameAsSource = [&](const EntrySpan& entry, const IniValue& value) {
+            std::string_view text(sourceText.data() + entry.valueBegin, entry.valueEnd - entry.valueBegin);
+            IniViewRange elements = value.getViews();
+            size_t count = 0;
+            for (size_t pos = 0; pos < text.size();) {
+                size_t comma = text.find(',', pos);
+                size_t end = (comma == std::string_view::npos) ? text.size() : comma;
+                std::string_view element = text.substr(pos, end - pos);
+                while (!element.empty() && std::string_view(" \t\n\r").find(element.front()) != std::string_view::npos) element.remove_prefix(1);
+                while (!element.empty() && std::string_view(" \t\n\r").find(element.back()) != std::string_view::npos) element.remove_suffix(1);
+                if (count == elements.size() || elements[count] != element) return false;
+                ++count;
+                if (comma == std::string_view::npos) break;
+                pos = comma + 1;
+            }
+            return count == elements.size();
+        };
+
+        // Keys written anywhere in the text, for the modified sections only
+        std::unordered_map<std::string, std::unordered_set<std::string>> writtenKeys;
+        for (const SourceSpan& span : sourceSpans) {
+            auto it = sections.find(span.section);
+            if (it == sections.end() || !it->second.dirty) continue;
+            std::unordered_set<std::string>& keys = writtenKeys[span.section];
+            for (const EntrySpan& entry : span.entries) {
+                keys.insert(keyOf(entry));
+            }
+        }
+
+        std::unordered_set<std::string> writtenSections;
+        for (const SourceSpan& span : sourceSpans) {
+            auto it = sections.find(span.section);
+            if (it == sections.end()) {
+                // Keep headers and comments without keys, drop removed sections
+                if (span.entries.empty()) copy(span.begin, span.end);
+                continue;
+            }
+            const IniSection& section = it->second;
+            bool firstSpan = writtenSections.insert(span.section).second;
+            if (!section.dirty) {
+                copy(span.begin, span.end);
+                continue;
+            }
+
+            size_t cursor = span.begin;
+            for (const EntrySpan& entry : span.entries) {
+                copy(cursor, entry.begin);
+                cursor = entry.end;
+                // Keys no longer in the section are dropped, also after it was removed and added again
+                std::string key = keyOf(entry);
+                const IniValue* value = section.find(IniKey(key));
+                if (value == nullptr) continue;
+                // Keys assigned the elements they already had keep their bytes, e.g. "1,2" isn't rewritten as "1, 2"
+                if (section.dirtyKeys.find(key) == section.dirtyKeys.end() || sameAsSource(entry, *value)) {
+                    copy(entry.begin, entry.end);
+                }
+                else {
+                    // Keep the key as written and any comment, replace only the value
+                    copy(entry.begin, entry.valueBegin);
+                    flush();
+                    value->appendString(out);
+                    copy(entry.valueEnd, entry.end);
+                }
+            }
+
+            if (firstSpan) {
+                // New keys go after the last key of the section, or after its header
+                size_t insertAt = cursor;
+                if (span.entries.empty() && span.hasHeader) {
+                    size_t headerEnd = sourceText.find('\n', span.begin);
+                    insertAt = (headerEnd == std::string::npos || headerEnd >= span.end) ? span.end : headerEnd + 1;
+                }
+                copy(cursor, insertAt);
+                cursor = insertAt;
+                flush();
+                const std::unordered_set<std::string>& keys = writtenKeys[span.section];
+                auto appendNew = [&](const IniSection::KeyValueMap::value_type& kv) {
+                    if (keys.find(kv.first) != keys.end()) return;
+                    if (!out.empty() && out.back() != '\n') out += newline;
+                    out += kv.first;
+                    out += '=';
+                    kv.second.appendString(out);
+                    out += newline;
+                };
+                if (sortedOutput) {
+                    for (const IniSection::KeyValueMap::value_type* kv : sortedKeys(section)) appendNew(*kv);
+                }
+                else {
+                    for (const auto& kv : section.keyValues) appendNew(kv);
+                }
+            }
+            copy(cursor, span.end);
+        }
+        flush();
+
+        std::string lines;
+        for (const SectionMap::value_type* sectionPair : orderedSections()) {
+            if (writtenSections.find(sectionPair->first) != writtenSections.end()) continue;
+            // Separate appended sections with a blank line, as save does, also when the text ends without a newline
+            if (!out.empty()) {
+                if (out.back() != '\n') out += newline;
+                size_t last = out.size() - 1;
+                if (last > 0 && out[last - 1] == '\r') --last;
+                if (last > 0 && out[last - 1] != '\n') out += newline;
+            }
+            if (!sourceCrlf) {
+                serializeSection(sectionPair->first, sectionPair->second, out, true, sortedOutput);
+                continue;
+            }
+            lines.clear();
+            serializeSection(sectionPair->first, sectionPair->second, lines, true, sortedOutput);
+            for (char c : lines) {
+                if (c == '\n') out += '\r';
+                out += c;
+            }
+        }
+    }
+
+    size_t IniFile::serializedLength() const {
+        size_t length = 0;
+        for (const auto& sectionPair : sections) {
+            length += sectionLength(sectionPair.first, sectionPair.second);
+        }
+        return length;
+    }
+
+    size_t IniFile::sectionLength(const std::string& name, const IniSection& section) {
+        size_t length = name.size() + 4; // "[", "]\n" and the trailing "\n"
+        for (const auto& kv : section.keyValues) {
+            length += kv.first.size() + kv.second.stringLength() + 2; // "=" and "\n"
+        }
+        return length;
+    }
+
+    std::vector<const IniFile::SectionMap::value_type*> IniFile::orderedSections() const {
+        std::vector<const SectionMap::value_type*> ordered;
+        ordered.reserve(sections.size());
+        for (const auto& sectionPair : sections) {
+            ordered.push_back(&sectionPair);
+        }
+        if (sortedOutput) {
+            std::sort(ordered.begin(), ordered.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+        }
+        return ordered;
+    }
+
+    std::vector<const IniSection::KeyValueMap::value_type*> IniFile::sortedKeys(const IniSection& section) {
+        // Sort on the first 8 bytes kept next to each pointer, so most comparisons don't reach into the map nodes
+        struct Entry {
+            std::uint64_t prefix;
+            const IniSection::KeyValueMap::value_type* kv;
+        };
+        std::vector<Entry> entries;
+        entries.reserve(section.keyValues.size());
+        for (const auto& kv : section.keyValues) {
+            std::uint64_t prefix = 0;
+            for (size_t i = 0; i < 8; ++i) {
+                prefix = (prefix << 8) | (i < kv.first.size() ? static_cast<unsigned char>(kv.first[i]) : 0);
+            }
+            entries.push_back(Entry{ prefix, &kv });
+        }
+        std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+            return a.prefix != b.prefix ? a.prefix < b.prefix : a.kv->first < b.kv->first;
+        });
+
+        std::vector<const IniSection::KeyValueMap::value_type*> ordered;
+        ordered.reserve(entries.size());
+        for (const Entry& entry : entries) {
+            ordered.push_back(entry.kv);
+        }
+        return ordered;
+    }
+
+    void IniFile::serialize(std::string& out) const {
+        if (!sortedOutput) {
+            for (const auto& sectionPair : sections) {
+                serializeSection(sectionPair.first, sectionPair.second, out);
+            }
+            return;
+        }
+        for (const SectionMap::value_type* sectionPair : orderedSections()) {
+            serializeSection(sectionPair->first, sectionPair->second, out, true, true);
+        }
+    }
+
+    std::vector<std::string> IniFile::serializeParallel(unsigned threads) const {
+        std::vector<const SectionMap::value_type*> ordered = orderedSections();
+
+        // Ranges are contiguous and equally sized, so each one maps to the buffer of its index
+        std::vector<std::string> buffers(threads);
+        size_t chunk = (ordered.size() + threads - 1) / threads;
+        runParallel(ordered.size(), threads, [&](size_t first, size_t last) {
+            if (first == last) return;
+            std::string& buffer = buffers[first / chunk];
+            size_t length = 0;
+            for (size_t i = first; i < last; ++i) {
+                length += sectionLength(ordered[i]->first, ordered[i]->second);
+            }
+            buffer.reserve(length);
+            for (size_t i = first; i < last; ++i) {
+                serializeSection(ordered[i]->first, ordered[i]->second, buffer, true, sortedOutput);
+            }
+        });
+        return buffers;
+    }
+
+    void IniFile::serializeSection(const std::string& name, const IniSection& section, std::string& out, bool header, bool sorted) {
+        if (header) {
+            out += '[';
+            out += name;
+            out.append("]\n", 2);
+        }
+        auto append = [&](const IniSection::KeyValueMap::value_type& kv) {
+            out += kv.first;
+            out += '=';
+            kv.second.appendString(out);
+            out += '\n';
+        };
+        if (sorted) {
+            for (const IniSection::KeyValueMap::value_type* kv : sortedKeys(section)) append(*kv);
+        }
+        else {
+            for (const auto& kv : section.keyValues) append(kv);
+        }
+        out += '\n';
+    }
+
     IniValue IniFile::get(const std::string& section, const std::string& key, const IniValue& defaultValue) const {
         auto it = sections.find(IniFile::toLower(section));
         return (it != sections.end()) ? it->second.get(key, defaultValue) : defaultValue;
     }
 
+    const IniValue& IniFile::getRef(const std::string& section, const std::string& key, const IniValue& defaultValue) const {
+        const IniValue* value = find(section, key);
+        return value ? *value : defaultValue;
+    }
+
+    IniSection* IniFile::find(const std::string& section) {
+        auto it = sections.find(toLower(section));
+        return (it != sections.end()) ? &it->second : nullptr;
+    }
+
+    const IniSection* IniFile::find(const std::string& section) const {
+        auto it = sections.find(toLower(section));
+        return (it != sections.end()) ? &it->second : nullptr;
+    }
+
+    IniValue* IniFile::find(const std::string& section, const std::string& key) {
+        IniSection* sec = find(section);
+        return sec ? sec->find(key) : nullptr;
+    }
+
+    const IniValue* IniFile::find(const std::string& section, const std::string& key) const {
+        const IniSection* sec = find(section);
+        return sec ? sec->find(key) : nullptr;
+    }
+
+    IniSection* IniFile::find(const IniKey& section) {
+        auto it = sections.find(section);
+        return (it != sections.end()) ? &it->second : nullptr;
+    }
+
+    const IniSection* IniFile::find(const IniKey& section) const {
+        auto it = sections.find(section);
+        return (it != sections.end()) ? &it->second : nullptr;
+    }
+
+    IniValue* IniFile::find(const IniKey& section, const IniKey& key) {
+        IniSection* sec = find(section);
+        return sec ? sec->find(key) : nullptr;
+    }
+
+    const IniValue* IniFile::find(const IniKey& section, const IniKey& key) const {
+        const IniSection* sec = find(section);
+        return sec ? sec->find(key) : nullptr;
+    }
+
+    size_t IniFile::getMany(const IniQuery& query, const IniValue** out) const {
+        size_t found = 0;
+        for (const IniQuery::SectionGroup& group : query.groups) {
+            const IniSection* sec = find(IniQuery::makeKey(group.name, group.hash));
+            for (const IniQuery::KeyEntry& entry : group.keys) {
+                const IniValue* value = sec ? sec->find(IniQuery::makeKey(entry.name, entry.hash)) : nullptr;
+                out[entry.slot] = value;
+                found += value != nullptr;
+            }
+        }
+        return found;
+    }
+
     void IniFile::set(const std::string& section, const std::string& key, const IniValue& value) {
-        sections[IniFile::toLower(section)].set(key, value);
+        insertSection(toLower(section)).first->second.set(key, value);
+        if (journalEnabled) appendJournal();
+    }
+
+    void IniFile::set(const std::string& section, const std::string& key, IniValue&& value) {
+        insertSection(toLower(section)).first->second.set(key, std::move(value));
+        if (journalEnabled) appendJournal();
     }
 
     bool IniFile::removeSection(const std::string& section) {
-        return sections.erase(toLower(section)) > 0;
+        std::string name = toLower(section);
+        auto secIt = sections.find(name);
+        if (secIt == sections.end()) return false;
+        if (secIt->second.journalQueued) {
+            journalSections.erase(std::remove(journalSections.begin(), journalSections.end(), name), journalSections.end());
+        }
+        sections.erase(secIt);
+        removedSections.insert(name);
+        if (journalEnabled) {
+            journalRemovedSections.push_back(std::move(name));
+            appendJournal();
+        }
+        return true;
     }
 
     bool IniFile::removeKey(const std::string& section, const std::string& key) {
         auto secIt = sections.find(toLower(section));
-        if (secIt != sections.end()) {
-            return secIt->second.removeKey(key);
+        if (secIt != sections.end() && secIt->second.removeKey(key)) {
+            if (journalEnabled) appendJournal();
+            return true;
         }
         return false;
     }
 
     void IniFile::clear() {
+        for (const auto& sectionPair : sections) {
+            removedSections.insert(sectionPair.first);
+            if (journalEnabled) journalRemovedSections.push_back(sectionPair.first);
+        }
         sections.clear();
+        journalSections.clear();
+        if (journalEnabled) appendJournal();
     }
 
     void IniFile::clearSection(const std::string& section) {
-        sections[toLower(section)].clear();
+        (*this)[section].clear();
+        if (journalEnabled) appendJournal();
     }
 
     bool IniFile::hasSection(const std::string& section) const {
@@ -207,7 +1342,9 @@ namespace IniLib {
     }
 
     IniSection& IniFile::operator[](const std::string& section) {
-        return sections[IniFile::toLower(section)];
+        auto result = insertSection(toLower(section));
+        if (result.second) result.first->second.dirty = true;
+        return result.first->second;
     }
 
     const IniSection& IniFile::operator[](const std::string& section) const {
@@ -218,8 +1355,51 @@ namespace IniLib {
         return it->second;
     }
 
+    IniSection& IniFile::operator[](const IniKey& section) {
+        auto it = sections.find(section);
+        if (it != sections.end()) {
+            return it->second;
+        }
+        IniSection& added = insertSection(toLower(std::string(section.name()))).first->second;
+        added.dirty = true;
+        return added;
+    }
+
+    const IniSection& IniFile::operator[](const IniKey& section) const {
+        auto it = sections.find(section);
+        if (it == sections.end()) {
+            throw IniFileException("Section \"" + std::string(section.name()) + "\" does not exist.");
+        }
+        return it->second;
+    }
+
     bool IniFile::addSection(const std::string& section) {
-        return sections.emplace(toLower(section), IniSection()).second;
+        auto result = insertSection(toLower(section));
+        if (result.second) result.first->second.dirty = true;
+        return result.second;
+    }
+
+    bool IniFile::isDirty() const {
+        if (!removedSections.empty()) return true;
+        for (const auto& sectionPair : sections) {
+            if (sectionPair.second.dirty) return true;
+        }
+        return false;
+    }
+
+    bool IniFile::isDirty(const std::string& section) const {
+        const IniSection* sec = find(section);
+        if (sec != nullptr) return sec->dirty;
+        return removedSections.find(toLower(section)) != removedSections.end();
+    }
+
+    void IniFile::markClean() {
+        for (auto& sectionPair : sections) {
+            sectionPair.second.markClean();
+        }
+        removedSections.clear();
+        journalSections.clear();
+        journalRemovedSections.clear();
     }
 
     // Helper functions
@@ -250,4 +1430,28 @@ namespace IniLib {
         return result;
     }
 
+    bool IniFile::matchPattern(std::string_view pattern, std::string_view name) {
+        size_t p = 0, n = 0, star = std::string_view::npos, resume = 0;
+        while (n < name.size()) {
+            if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+                ++p;
+                ++n;
+            }
+            else if (p < pattern.size() && pattern[p] == '*') {
+                star = p++;
+                resume = n;
+            }
+            else if (star != std::string_view::npos) {
+                // Let the last * absorb one more character and retry
+                p = star + 1;
+                n = ++resume;
+            }
+            else {
+                return false;
+            }
+        }
+        while (p < pattern.size() && pattern[p] == '*') ++p;
+        return p == pattern.size();
+    }
+
 } // namespace IniLib
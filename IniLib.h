@@ -41,10 +41,23 @@ SOFTWARE.
 #endif
 
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <memory>
+#include <iterator>
+#include <utility>
+#include <any>
+#include <atomic>
+#include <cstdint>
 #include <vector>
 #include <stdexcept>
 #include <type_traits>
+#include <thread>
+#include <functional>
+#include <iosfwd>
+#include <exception>
 #include "IniValueConvert.h"
 
 namespace IniLib {
@@ -65,13 +78,270 @@ namespace IniLib {
     // Forward declaration of classes
     class IniFile;
     class IniSection;
+    class IniSchema;
+    class IniSchemaValidator;
+    struct IniSchemaViolation;
+
+    /**
+     * @class IniKey
+     * @brief Section or key name with its case-insensitive hash precomputed.
+     *
+     * Lookups taking an IniKey skip case folding and hashing, leaving only the
+     * bucket probe and a name comparison. Use the _key literal to compute the
+     * hash at compile time:
+     *
+     * @code
+     * using namespace IniLib::literals;
+     * int power = ini["car"_key]["power"_key].getAs<int>();
+     * @endcode
+     */
+    class IniKey {
+    public:
+        /**
+         * @brief Constructor hashing the given name
+         * @param name The section or key name, which must outlive the IniKey
+         */
+        constexpr explicit IniKey(std::string_view name) : keyName(name), keyHash(hashKey(name)) {}
+
+        /**
+         * @brief Returns the name, as given
+         * @return std::string_view The name
+         */
+        constexpr std::string_view name() const { return keyName; }
+
+        /**
+         * @brief Returns the case-insensitive hash of the name
+         * @return size_t The hash
+         */
+        constexpr size_t hash() const { return keyHash; }
+
+    private:
+        std::string_view keyName; ///< The name, as given
+        size_t keyHash;           ///< Case-insensitive hash of the name
+
+        /// @brief Constructor reusing a hash computed earlier
+        constexpr IniKey(std::string_view name, size_t hash) : keyName(name), keyHash(hash) {}
+
+        friend class IniQuery; ///< Allow IniQuery to rebuild keys from its stored hashes
+    };
+
+    namespace literals {
+
+        /**
+         * @brief Creates an IniKey from a string literal, hashing it at compile time
+         * @param name The literal characters
+         * @param length The literal length
+         * @return IniKey The key
+         */
+        consteval IniKey operator""_key(const char* name, size_t length) {
+            return IniKey(std::string_view(name, length));
+        }
+
+    } // namespace literals
+
+    /**
+     * @struct IniKeyHash
+     * @brief Hash functor for section and key maps, accepting both names and IniKeys.
+     */
+    struct IniKeyHash {
+        using is_transparent = void; ///< Enables lookups by IniKey without building a std::string
+
+        /// @brief Hashes a stored name
+        size_t operator()(const std::string& name) const { return hashKey(name); }
+
+        /// @brief Returns the precomputed hash of an IniKey
+        size_t operator()(const IniKey& key) const { return key.hash(); }
+    };
+
+    /**
+     * @struct IniKeyEqual
+     * @brief Equality functor for section and key maps, accepting both names and IniKeys.
+     */
+    struct IniKeyEqual {
+        using is_transparent = void; ///< Enables lookups by IniKey without building a std::string
+
+        /// @brief Compares two stored names
+        bool operator()(const std::string& a, const std::string& b) const { return a == b; }
+
+        /// @brief Compares an IniKey with a stored, lowercase name
+        bool operator()(const IniKey& a, const std::string& b) const { return keyEquals(a.name(), b); }
+
+        /// @brief Compares a stored, lowercase name with an IniKey
+        bool operator()(const std::string& a, const IniKey& b) const { return keyEquals(a, b.name()); }
+    };
+
+    /**
+     * @struct DecodeResult
+     * @brief Outcome of decoding an IniValue into caller-provided storage.
+     *
+     * When success is false, count is also the index of the element that failed to decode.
+     */
+    struct DecodeResult {
+        size_t count;  ///< Number of elements written to the output
+        bool success;  ///< true if every requested element was decoded
+    };
+
+    /**
+     * @struct IniColumn
+     * @brief Values of one key extracted from many sections, in structure-of-arrays layout.
+     *
+     * values[i] was read from the section named sections[i]. Section names are views
+     * into the IniFile, valid until its sections are modified.
+     *
+     * @tparam T The type of the values.
+     */
+    template<typename T>
+    struct IniColumn {
+        std::vector<T> values;                  ///< Decoded values, one per section
+        std::vector<std::string_view> sections; ///< Lowercase names of the sections the values were read from
+    };
+
+    /**
+     * @class IniArray
+     * @brief Owning, fixed-size array returned by IniValue::getArrayAs.
+     * @tparam T The element type.
+     */
+    template<typename T>
+    class IniArray {
+    public:
+        /// @brief Default constructor, creates an empty array
+        IniArray() = default;
+
+        /// @brief Constructor allocating an array of the given size
+        explicit IniArray(size_t size) : elements(size ? new T[size] : nullptr), count(size) {}
+
+        /// @brief Move constructor, leaving other empty
+        IniArray(IniArray&& other) noexcept : elements(std::move(other.elements)), count(std::exchange(other.count, 0)) {}
+
+        /// @brief Move assignment operator, leaving other empty
+        IniArray& operator=(IniArray&& other) noexcept {
+            elements = std::move(other.elements);
+            count = std::exchange(other.count, 0);
+            return *this;
+        }
+
+        /**
+         * @brief Returns the number of elements in the array
+         * @return size_t Number of elements
+         */
+        size_t size() const { return count; }
+
+        /**
+         * @brief Checks if the array is empty
+         * @return true if the array has no elements, false otherwise
+         */
+        bool empty() const { return count == 0; }
+
+        /// @brief Returns a pointer to the first element
+        T* data() { return elements.get(); }
+
+        /// @brief Returns a const pointer to the first element
+        const T* data() const { return elements.get(); }
+
+        /// @brief Returns an iterator to the first element
+        T* begin() { return elements.get(); }
+
+        /// @brief Returns an iterator past the last element
+        T* end() { return elements.get() + count; }
+
+        /// @brief Returns a const iterator to the first element
+        const T* begin() const { return elements.get(); }
+
+        /// @brief Returns a const iterator past the last element
+        const T* end() const { return elements.get() + count; }
+
+        /// @brief Accesses an element by index, without bounds checking
+        T& operator[](size_t index) { return elements[index]; }
+
+        /// @brief Const version of subscript operator
+        const T& operator[](size_t index) const { return elements[index]; }
+
+        /**
+         * @brief Releases ownership of the underlying allocation
+         * @return T* Pointer to an array allocated with new[], to be freed with delete[]
+         */
+        T* release() {
+            count = 0;
+            return elements.release();
+        }
+
+    private:
+        std::unique_ptr<T[]> elements; ///< The owned elements
+        size_t count = 0;              ///< Number of elements
+    };
+
+    /**
+     * @class IniViewRange
+     * @brief Non-owning range of std::string_view over the elements of an IniValue.
+     *
+     * The range is invalidated by any modification of the IniValue it refers to.
+     */
+    class IniViewRange {
+    public:
+        /**
+         * @class iterator
+         * @brief Forward iterator yielding a std::string_view for each element
+         */
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = std::string_view;
+
+            /// @brief Constructor wrapping an element pointer
+            explicit iterator(const std::string* element = nullptr) : element(element) {}
+
+            /// @brief Returns a view of the current element
+            std::string_view operator*() const { return *element; }
+
+            /// @brief Advances to the next element
+            iterator& operator++() { ++element; return *this; }
+
+            /// @brief Advances to the next element, returning the previous position
+            iterator operator++(int) { iterator previous = *this; ++element; return previous; }
+
+            /// @brief Equality comparison
+            bool operator==(const iterator& other) const { return element == other.element; }
+
+            /// @brief Inequality comparison
+            bool operator!=(const iterator& other) const { return element != other.element; }
+
+        private:
+            const std::string* element; ///< Current element
+        };
+
+        /// @brief Constructor from a contiguous range of strings
+        IniViewRange(const std::string* first, size_t count) : first(first), count(count) {}
+
+        /// @brief Returns an iterator to the first element
+        iterator begin() const { return iterator(first); }
+
+        /// @brief Returns an iterator past the last element
+        iterator end() const { return iterator(first + count); }
+
+        /// @brief Returns the number of elements in the range
+        size_t size() const { return count; }
+
+        /// @brief Checks if the range is empty
+        bool empty() const { return count == 0; }
+
+        /// @brief Returns a view of the element at the given index, without bounds checking
+        std::string_view operator[](size_t index) const { return first[index]; }
+
+    private:
+        const std::string* first; ///< First element of the range
+        size_t count;             ///< Number of elements in the range
+    };
 
     /**
      * @class IniValue
      * @brief Wrapper class for handling values stored in the INI file.
      *
      * IniValue encapsulates a vector of strings and provides utilities to
-     * manage, retrieve, and append INI key values.
+     * manage, retrieve, and append INI key values. Values assigned from integral,
+     * enumeration or fixed-point types are kept in native form and encoded on demand.
      */
     class IniValue {
     public:
@@ -81,32 +351,74 @@ namespace IniLib {
         /// @brief Constructor initializing from a vector of strings
         IniValue(const std::vector<std::string>& values) : values(values) {}
 
+        /// @brief Constructor taking ownership of a vector of strings
+        IniValue(std::vector<std::string>&& values) : values(std::move(values)) {}
+
         /// @brief Constructor initializing from an initializer list
         IniValue(std::initializer_list<std::string> values) : values(values) {}
 
         /// @brief Constructor initializing from a single string
         IniValue(const std::string& value) : values({ value }) {}
 
+        /// @brief Constructor taking ownership of a single string
+        IniValue(std::string&& value) {
+            values.push_back(std::move(value));
+        }
+
         /// @brief Constructor initializing from an array of characters
         IniValue(const char value[]) : values({value}) {}
 
+        /// @brief Copy constructor, safe while other threads read the source
+        IniValue(const IniValue& other) { copyFrom(other); }
+
+        /// @brief Move constructor, leaving other empty
+        IniValue(IniValue&& other) noexcept
+            : values(std::move(other.values)), native(std::move(other.native)), nativeOps(other.nativeOps),
+              textValid(other.textValid.load(std::memory_order_relaxed)) {
+            other.values.clear();
+            other.resetNative();
+        }
+
+        /// @brief Copy assignment, safe while other threads read the source
+        IniValue& operator=(const IniValue& other) {
+            if (this != &other) {
+                copyFrom(other);
+                modified();
+            }
+            return *this;
+        }
+
+        /// @brief Move assignment, leaving other empty
+        IniValue& operator=(IniValue&& other) {
+            if (this != &other) {
+                values = std::move(other.values);
+                native = std::move(other.native);
+                nativeOps = other.nativeOps;
+                textValid.store(other.textValid.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                other.values.clear();
+                other.resetNative();
+                modified();
+            }
+            return *this;
+        }
+
         /**
          * @brief Returns the length of the underlying vector
          * @return size_t Number of elements in the vector
          */
-        size_t length() const { return values.size(); }
+        size_t length() const { return textValid.load(std::memory_order_acquire) ? values.size() : nativeOps->length(native); }
 
         /**
          * @brief Checks if the IniValue represents a vector of values
          * @return true if the value contains more than one entry, false otherwise
          */
-        bool isVector() const { return values.size() > 1; }
+        bool isVector() const { return length() > 1; }
 
         /**
          * @brief Returns the vector of strings
          * @return std::vector<std::string> The underlying vector of values
          */
-        std::vector<std::string> getVector() const { return values; }
+        std::vector<std::string> getVector() const { return text(); }
 
         /**
          * @brief Returns a string representation of the value
@@ -119,6 +431,38 @@ namespace IniLib {
          */
         std::string getString() const;
 
+        /**
+         * @brief Returns a non-owning view of a single element
+         * @param index Index of the element to view
+         * @return std::string_view View of the element at the specified index
+         * @throws IniFileException if the index is out of bounds
+         */
+        std::string_view getView(size_t index = 0) const;
+
+        /**
+         * @brief Returns a non-owning range of views over all elements
+         * @return IniViewRange Range of std::string_view, valid until the value is modified
+         */
+        IniViewRange getViews() const {
+            const std::vector<std::string>& elements = text();
+            return IniViewRange(elements.data(), elements.size());
+        }
+
+        /**
+         * @brief Returns the length of the string representation of the value
+         * @return size_t Number of characters getString() would return
+         */
+        size_t stringLength() const;
+
+        /**
+         * @brief Appends the string representation of the value to a caller-provided buffer
+         *
+         * Equivalent to out += getString(), without building a temporary string.
+         *
+         * @param out The buffer to append to
+         */
+        void appendString(std::string& out) const;
+
         /**
          * @brief Appends a string to the value
          * @param value String to be appended to the vector
@@ -132,6 +476,9 @@ namespace IniLib {
 
         /**
          * @brief Accesses the underlying vector by index
+         *
+         * The value counts as modified, since the element may be changed through the reference.
+         *
          * @param index Index of the element to access
          * @return std::string& Reference to the element at the specified index
          * @throws IniFileException if the index is out of bounds
@@ -154,10 +501,16 @@ namespace IniLib {
          */
         template<typename T>
         T getAs() const {
-            if (values.empty()) {
+            const T* data;
+            size_t count;
+            if (nativeElements(data, count) && count > 0) {
+                return data[0];
+            }
+            const std::vector<std::string>& elements = text();
+            if (elements.empty()) {
                 throw IniValueConvertException("IniValue is empty");
             }
-            return IniValueConvert<T>::decode(values[0]);
+            return IniValueConvert<T>::decode(elements[0]);
         }
 
         /**
@@ -168,32 +521,146 @@ namespace IniLib {
          */
         template<typename T>
         std::vector<T> getVectorAs() const {
+            const T* data;
+            size_t count;
+            if (nativeElements(data, count)) {
+                return std::vector<T>(data, data + count);
+            }
+            const std::vector<std::string>& elements = text();
             std::vector<T> result;
-            for (const std::string& str : values) {
+            result.reserve(elements.size());
+            for (const std::string& str : elements) {
                 result.push_back(IniValueConvert<T>::decode(str));
             }
             return result;
         }
 
         /**
-         * @brief Returns a C-style array of values of type T.
+         * @brief Decodes up to n values of type T directly into caller-provided memory.
+         *
+         * No allocation is performed. Decoding stops at the first element that fails
+         * to convert, leaving the remaining output untouched. Types whose converter
+         * provides tryDecode are decoded without exceptions.
+         *
+         * @tparam T The type to convert the string values to.
+         * @param out Pointer to the first element of the destination buffer.
+         * @param n Capacity of the destination buffer, in elements.
+         * @return DecodeResult Number of elements written and whether all of them succeeded.
+         */
+        template<typename T>
+        DecodeResult decodeInto(T* out, size_t n) const {
+            const T* data;
+            size_t count;
+            if (nativeElements(data, count)) {
+                count = std::min(n, count);
+                std::copy(data, data + count, out);
+                return DecodeResult{ count, true };
+            }
+            const std::vector<std::string>& elements = text();
+            count = std::min(n, elements.size());
+            for (size_t i = 0; i < count; ++i) {
+                if constexpr (HasTryDecode<T>::value) {
+                    if (!IniValueConvert<T>::tryDecode(elements[i], out[i])) {
+                        return DecodeResult{ i, false };
+                    }
+                }
+                else {
+                    try {
+                        out[i] = IniValueConvert<T>::decode(elements[i]);
+                    }
+                    catch (const IniValueConvertException&) {
+                        return DecodeResult{ i, false };
+                    }
+                }
+            }
+            return DecodeResult{ count, true };
+        }
+
+        /**
+         * @brief Decodes all values as type T into an output iterator.
+         *
+         * Decoding stops at the first element that fails to convert.
+         *
+         * @tparam T The type to convert the string values to.
+         * @tparam OutputIt The output iterator type.
+         * @param out Output iterator receiving the decoded values.
+         * @return DecodeResult Number of elements written and whether all of them succeeded.
+         */
+        template<typename T, typename OutputIt>
+        DecodeResult decodeInto(OutputIt out) const {
+            const T* data;
+            size_t count;
+            if (nativeElements(data, count)) {
+                std::copy(data, data + count, out);
+                return DecodeResult{ count, true };
+            }
+            const std::vector<std::string>& elements = text();
+            for (size_t i = 0; i < elements.size(); ++i) {
+                if constexpr (HasTryDecode<T>::value) {
+                    T value{};
+                    if (!IniValueConvert<T>::tryDecode(elements[i], value)) {
+                        return DecodeResult{ i, false };
+                    }
+                    *out = value;
+                }
+                else {
+                    try {
+                        *out = IniValueConvert<T>::decode(elements[i]);
+                    }
+                    catch (const IniValueConvertException&) {
+                        return DecodeResult{ i, false };
+                    }
+                }
+                ++out;
+            }
+            return DecodeResult{ elements.size(), true };
+        }
+
+        /**
+         * @brief Returns an owning array of values of type T.
+         *
+         * Values are decoded directly into the array's single allocation.
+         *
          * @tparam T The type to convert the string values to.
-         * @return T* A pointer to a dynamically allocated C-style array.
+         * @return IniArray<T> The array of values of type T, with its length.
          * @throws IniValueConvertException if conversion fails.
          */
         template<typename T>
-        T* getArrayAs() const {
-            std::vector<T> vec = getVectorAs<T>();
-            T* array = new T[vec.size()];
-            std::copy(vec.begin(), vec.end(), array);
+        IniArray<T> getArrayAs() const {
+            const T* data;
+            size_t count;
+            if (nativeElements(data, count)) {
+                IniArray<T> array(count);
+                std::copy(data, data + count, array.begin());
+                return array;
+            }
+            const std::vector<std::string>& elements = text();
+            IniArray<T> array(elements.size());
+            for (size_t i = 0; i < elements.size(); ++i) {
+                array[i] = IniValueConvert<T>::decode(elements[i]);
+            }
             return array;
         }
 
+        /**
+         * @brief Decodes up to n boolean values packed into caller-provided 64-bit words.
+         *
+         * Element i is stored in bit (i % 64) of words[i / 64]. Every word that receives
+         * a bit is cleared first. Decoding stops at the first element that is not a
+         * boolean, leaving the remaining bits untouched.
+         *
+         * @param words Pointer to the first word of the destination bitset.
+         * @param n Capacity of the destination bitset, in bits.
+         * @return DecodeResult Number of bits written and whether all of them succeeded.
+         */
+        DecodeResult decodeBitsInto(std::uint64_t* words, size_t n) const;
+
         /**
          * @brief Templated assignment operator for a single value of type T.
          *
-         * This operator uses IniValueConvert<T>::encode to convert the value to a string
-         * and assigns it to the internal vector, clearing any previous contents.
+         * Types with an exact text round trip (see IniNativeStorable) are kept in native
+         * form and only encoded when their text is needed. Others are converted with
+         * IniValueConvert<T>::encode immediately. Any previous contents are replaced.
          *
          * @tparam T The type of the value to be assigned.
          * @param value The value to assign.
@@ -201,16 +668,24 @@ namespace IniLib {
          */
         template<typename T>
         IniValue& operator=(const T& value) {
-            values.clear();
-            values.push_back(IniValueConvert<T>::encode(value));
+            if constexpr (IniNativeStorable<T>::value) {
+                setNative(value, &scalarOps<T>);
+            }
+            else {
+                resetNative();
+                values.clear();
+                values.push_back(IniValueConvert<T>::encode(value));
+            }
+            modified();
             return *this;
         }
 
         /**
          * @brief Templated assignment operator for an array of values of type T.
          *
-         * This operator uses IniValueConvert<T>::encode to convert each value in the array
-         * to a string and assigns them to the internal vector, clearing any previous contents.
+         * Arrays of types with an exact text round trip are kept in native form,
+         * others are converted with IniValueConvert<T>::encode immediately.
+         * Any previous contents are replaced.
          *
          * @tparam T The type of the values in the array.
          * @tparam N The size of the array.
@@ -219,27 +694,37 @@ namespace IniLib {
          */
         template<typename T, size_t N>
         IniValue& operator=(T(&arr)[N]) {
-            values.clear();
+            using Element = std::remove_const_t<T>;
 
             //check if T is a const char * (string literal)
-            if (std::is_same<T, const char>::value)
+            if constexpr (std::is_same<T, const char>::value)
             {
+                resetNative();
+                values.clear();
                 values.push_back(IniValueConvert<const char*>::encode((const char*)arr));
             }
+            else if constexpr (IniNativeArray<Element>::value)
+            {
+                setNative(std::vector<Element>(arr, arr + N), &arrayOps<Element>);
+            }
             else
             {
+                resetNative();
+                values.clear();
                 for (size_t i = 0; i < N; ++i) {
-                    values.push_back(IniValueConvert<T>::encode(arr[i]));
+                    values.push_back(IniValueConvert<Element>::encode(arr[i]));
                 }
             }
+            modified();
             return *this;
         }
 
         /**
          * @brief Templated assignment operator for an initializer_list of values of type T.
          *
-         * This operator uses IniValueConvert<T>::encode to convert each value in the initializer_list
-         * to a string and assigns them to the internal vector, clearing any previous contents.
+         * Lists of types with an exact text round trip are kept in native form,
+         * others are converted with IniValueConvert<T>::encode immediately.
+         * Any previous contents are replaced.
          *
          * @tparam T The type of the values in the initializer_list.
          * @param list The initializer_list of values to assign.
@@ -247,18 +732,26 @@ namespace IniLib {
          */
         template<typename T>
         IniValue& operator=(std::initializer_list<T> list) {
-            values.clear();
-            for (const T& value : list) {
-                values.push_back(IniValueConvert<T>::encode(value));
+            if constexpr (IniNativeArray<T>::value) {
+                setNative(std::vector<T>(list), &arrayOps<T>);
+            }
+            else {
+                resetNative();
+                values.clear();
+                for (const T& value : list) {
+                    values.push_back(IniValueConvert<T>::encode(value));
+                }
             }
+            modified();
             return *this;
         }
 
         /**
          * @brief Templated assignment operator for a vector of values of type T.
          *
-         * This operator uses IniValueConvert<T>::encode to convert each value in the vector
-         * to a string and assigns them to the internal vector, clearing any previous contents.
+         * Vectors of types with an exact text round trip are kept in native form,
+         * others are converted with IniValueConvert<T>::encode immediately.
+         * Any previous contents are replaced.
          *
          * @tparam T The type of the values in the vector.
          * @param vec The vector of values to assign.
@@ -266,23 +759,161 @@ namespace IniLib {
          */
         template<typename T>
         IniValue& operator=(const std::vector<T>& vec) {
-            values.clear();
-            for (const T& value : vec) {
-                values.push_back(IniValueConvert<T>::encode(value));
+            if constexpr (IniNativeArray<T>::value) {
+                setNative(vec, &arrayOps<T>);
+            }
+            else {
+                resetNative();
+                values.clear();
+                values.reserve(vec.size());
+                for (const T& value : vec) {
+                    values.push_back(IniValueConvert<T>::encode(value));
+                }
             }
+            modified();
             return *this;
         }
 
     private:
-        std::vector<std::string> values; ///< The underlying vector of values
+        /// @brief Operations on a native payload, instantiated for each stored type
+        struct NativeOps {
+            size_t(*length)(const std::any& payload);                                 ///< Number of elements in the payload
+            void(*encode)(const std::any& payload, std::vector<std::string>& out);   ///< Appends the text of each element
+        };
+
+        /// @brief Operations on a native scalar of type T
+        template<typename T>
+        static inline const NativeOps scalarOps = {
+            [](const std::any&) -> size_t { return 1; },
+            [](const std::any& payload, std::vector<std::string>& out) {
+                out.push_back(IniValueConvert<T>::encode(*std::any_cast<T>(&payload)));
+            }
+        };
+
+        /// @brief Operations on a native std::vector<T>
+        template<typename T>
+        static inline const NativeOps arrayOps = {
+            [](const std::any& payload) -> size_t { return std::any_cast<std::vector<T>>(&payload)->size(); },
+            [](const std::any& payload, std::vector<std::string>& out) {
+                const std::vector<T>& array = *std::any_cast<std::vector<T>>(&payload);
+                out.reserve(array.size());
+                for (const T& value : array) {
+                    out.push_back(IniValueConvert<T>::encode(value));
+                }
+            }
+        };
+
+        /// @brief Native types whose arrays can be stored; std::vector<bool> has no contiguous data
+        template<typename T>
+        using IniNativeArray = std::bool_constant<IniNativeStorable<T>::value && !std::is_same<T, bool>::value>;
+
+        mutable std::vector<std::string> values;    ///< The underlying vector of values, encoded lazily from native
+        std::any native;                            ///< Native payload, a T or std::vector<T>, if assigned from one
+        const NativeOps* nativeOps = nullptr;       ///< Operations on the native payload, nullptr if there is none
+        mutable std::atomic<bool> textValid = true; ///< Whether values holds the text of the native payload
+        IniSection* owner = nullptr;                ///< Section notified of modifications, if the value is stored in one
+        const std::string* ownerKey = nullptr;      ///< Lowercase key of the value in its owner
+
+        /**
+         * @brief Records a modification of the value in its owning section, if any
+         */
+        void modified();
+
+        /**
+         * @brief Returns the text elements, encoding them from the native payload if needed
+         *
+         * Const accessors may run concurrently: the first one to need the text encodes it
+         * under a lock, and the others wait for it.
+         *
+         * @return const std::vector<std::string>& The text elements
+         */
+        const std::vector<std::string>& text() const {
+            if (!textValid.load(std::memory_order_acquire)) {
+                encodeText();
+            }
+            return values;
+        }
+
+        /**
+         * @brief Fills the text cache from the native payload, once, even when called concurrently
+         */
+        void encodeText() const;
+
+        /**
+         * @brief Copies another value, reading its text cache only once it is complete
+         * @param other The value to copy
+         */
+        void copyFrom(const IniValue& other) {
+            bool valid = other.textValid.load(std::memory_order_acquire);
+            native = other.native;
+            nativeOps = other.nativeOps;
+            if (valid) {
+                values = other.values;
+            }
+            else {
+                values.clear();
+            }
+            textValid.store(valid, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Returns the native elements, if the value was assigned from a T or std::vector<T>
+         * @tparam T The requested element type
+         * @param data Receives a pointer to the first element
+         * @param count Receives the number of elements
+         * @return true if a native payload of type T is present, false otherwise
+         */
+        template<typename T>
+        bool nativeElements(const T*& data, size_t& count) const {
+            if constexpr (IniNativeStorable<T>::value) {
+                if (nativeOps == nullptr) return false;
+                if (const T* scalar = std::any_cast<T>(&native)) {
+                    data = scalar;
+                    count = 1;
+                    return true;
+                }
+                if constexpr (IniNativeArray<T>::value) {
+                    if (const std::vector<T>* array = std::any_cast<std::vector<T>>(&native)) {
+                        data = array->data();
+                        count = array->size();
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Replaces the contents with a native payload, deferring its encoding
+         * @param payload The payload to store
+         * @param ops Operations on the payload
+         */
+        template<typename P>
+        void setNative(P&& payload, const NativeOps* ops) {
+            native = std::forward<P>(payload);
+            nativeOps = ops;
+            values.clear();
+            textValid.store(false, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Drops the native payload, before the text is replaced
+         */
+        void resetNative() {
+            native.reset();
+            nativeOps = nullptr;
+            textValid.store(true, std::memory_order_relaxed);
+        }
 
         /**
-         * @brief Joins a vector of strings into a single string, separated by a delimiter
-         * @param vec Vector of strings to join
-         * @param delimiter Delimiter to separate each element
-         * @return std::string The concatenated string
+         * @brief Encodes and drops the native payload, before the text is modified in place
          */
-        static std::string join(const std::vector<std::string>& vec, const std::string& delimiter);
+        void detachNative() {
+            text();
+            resetNative();
+        }
+
+        friend class IniSection; ///< Allow IniSection to bind stored values to itself
     };
 
     /**
@@ -291,7 +922,7 @@ namespace IniLib {
      */
     class IniSection {
     public:
-        using KeyValueMap = std::unordered_map<std::string, IniValue>; ///< Map of key-value pairs in the section
+        using KeyValueMap = std::unordered_map<std::string, IniValue, IniKeyHash, IniKeyEqual>; ///< Map of key-value pairs in the section
 
         /**
          * @brief Retrieves a value for a given key
@@ -302,36 +933,99 @@ namespace IniLib {
         IniValue get(const std::string& key, const IniValue& defaultValue = IniValue()) const;
 
         /**
-         * @brief Sets a value for a given key
-         * @param key The key to set the value for
-         * @param value The value to set
+         * @brief Retrieves a reference to the value for a given key, without copying it
+         * @param key The key to look for
+         * @param defaultValue Value to return if the key is not found
+         * @return const IniValue& The value associated with the key, or defaultValue if not found
+         * @note When the key is missing the returned reference is defaultValue itself, so it must outlive the result
          */
-        void set(const std::string& key, const IniValue& value);
+        const IniValue& getRef(const std::string& key, const IniValue& defaultValue) const;
 
         /**
-         * @brief Removes a key from the section
-         * @param key The key to remove
-         * @return true if the key was removed, false otherwise
+         * @brief Looks up the value for a given key
+         *
+         * @param key The key to look for
+         * @return IniValue* Pointer to the value, or nullptr if the key is not found
          */
-        bool removeKey(const std::string& key);
+        IniValue* find(const std::string& key);
 
         /**
-         * @brief Clears all key-value pairs in the section
+         * @brief Const version of find
+         * @param key The key to look for
+         * @return const IniValue* Pointer to the value, or nullptr if the key is not found
          */
-        void clear();
+        const IniValue* find(const std::string& key) const;
 
         /**
-         * @brief Checks if a key exists in the section
-         * @param key The key to check for
-         * @return true if the key exists, false otherwise
+         * @brief Looks up the value for a precomputed key, without folding or hashing it
+         *
+         * @param key The key to look for
+         * @return IniValue* Pointer to the value, or nullptr if the key is not found
          */
-        bool hasKey(const std::string& key) const;
+        IniValue* find(const IniKey& key);
 
         /**
-         * @brief Returns the number of keys in the section
-         * @return size_t The number of keys in the section
+         * @brief Const version of find
+         * @param key The key to look for
+         * @return const IniValue* Pointer to the value, or nullptr if the key is not found
          */
-        size_t keyCount() const;
+        const IniValue* find(const IniKey& key) const;
+
+        /**
+         * @brief Sets a value for a given key
+         * @param key The key to set the value for
+         * @param value The value to set
+         */
+        void set(const std::string& key, const IniValue& value);
+
+        /**
+         * @brief Sets a value for a given key, taking ownership of the value
+         * @param key The key to set the value for
+         * @param value The value to move into the section
+         */
+        void set(const std::string& key, IniValue&& value);
+
+        /**
+         * @brief Constructs a value in place for a given key, replacing any existing value
+         * @tparam Args Types of the IniValue constructor arguments
+         * @param key The key to set the value for
+         * @param args Arguments forwarded to the IniValue constructor
+         * @return IniValue& Reference to the stored value
+         */
+        template<typename... Args>
+        IniValue& emplace(const std::string& key, Args&&... args);
+
+        /**
+         * @brief Removes a key from the section
+         * @param key The key to remove
+         * @return true if the key was removed, false otherwise
+         */
+        bool removeKey(const std::string& key);
+
+        /**
+         * @brief Clears all key-value pairs in the section
+         */
+        void clear();
+
+        /**
+         * @brief Checks if a key exists in the section
+         * @param key The key to check for
+         * @return true if the key exists, false otherwise
+         */
+        bool hasKey(const std::string& key) const;
+
+        /**
+         * @brief Checks if a precomputed key exists in the section
+         * @param key The key to check for
+         * @return true if the key exists, false otherwise
+         */
+        bool hasKey(const IniKey& key) const { return find(key) != nullptr; }
+
+        /**
+         * @brief Returns the number of keys in the section
+         * @return size_t The number of keys in the section
+         */
+        size_t keyCount() const;
 
         /**
          * @brief Accesses a value by key, creates the key if it doesn't exist
@@ -348,10 +1042,171 @@ namespace IniLib {
          */
         const IniValue& operator[](const std::string& key) const;
 
+        /**
+         * @brief Accesses a value by precomputed key, creates the key if it doesn't exist
+         * @param key The key to access
+         * @return IniValue& Reference to the value associated with the key
+         */
+        IniValue& operator[](const IniKey& key);
+
+        /**
+         * @brief Const version of subscript operator
+         * @param key The key to access
+         * @return const IniValue& Reference to the value associated with the key
+         * @throws IniFileException if the key doesn't exist
+         */
+        const IniValue& operator[](const IniKey& key) const;
+
+        /**
+         * @brief Returns an iterator to the first key-value pair
+         * @return KeyValueMap::const_iterator Iterator over (lowercase key, value) pairs, in no particular order
+         */
+        KeyValueMap::const_iterator begin() const { return keyValues.begin(); }
+
+        /**
+         * @brief Returns an iterator past the last key-value pair
+         * @return KeyValueMap::const_iterator End iterator
+         */
+        KeyValueMap::const_iterator end() const { return keyValues.end(); }
+
+        /**
+         * @brief Checks if the section was modified since it was loaded or last saved with saveChanges
+         *
+         * Assignments through references returned by non-const accessors count as modifications,
+         * lookups alone don't. Values that still match the loaded text keep their original bytes
+         * when saved.
+         *
+         * @return true if any key was added, assigned or removed, false otherwise
+         */
+        bool isDirty() const { return dirty; }
+
+        /**
+         * @brief Checks if a key was modified since it was loaded or last saved with saveChanges
+         * @param key The key to check
+         * @return true if the key was added, assigned or removed, false otherwise
+         */
+        bool isDirty(const std::string& key) const;
+
+        /// @brief Default constructor
+        IniSection() = default;
+
+        /// @brief Copy constructor, keeping the recorded modifications
+        IniSection(const IniSection& other);
+
+        /// @brief Move constructor, keeping the recorded modifications
+        IniSection(IniSection&& other);
+
+        /// @brief Copy assignment, recording every replaced and assigned key as modified
+        IniSection& operator=(const IniSection& other);
+
+        /// @brief Move assignment, recording every replaced and assigned key as modified
+        IniSection& operator=(IniSection&& other);
+
     private:
-        KeyValueMap keyValues; ///< Map of keys and values
+        KeyValueMap keyValues;                     ///< Map of keys and values
+        std::unordered_set<std::string> dirtyKeys; ///< Lowercase keys modified since the last load or saveChanges
+        bool dirty = false;                        ///< Whether the section was modified since the last load or saveChanges
+        std::unordered_set<std::string> journalKeys; ///< Lowercase keys modified since the last appendJournal
+        bool journalQueued = false;                ///< Whether the section is queued for the next appendJournal
+        IniFile* file = nullptr;                   ///< File holding the section, notified of modifications to journal
+        const std::string* name = nullptr;         ///< Lowercase name of the section in its file
+
+        /**
+         * @brief Makes a stored value report its modifications to this section
+         * @param entry The key and value, stored in keyValues
+         */
+        void adopt(KeyValueMap::value_type& entry) {
+            entry.second.owner = this;
+            entry.second.ownerKey = &entry.first;
+        }
+
+        /**
+         * @brief Makes every stored value report its modifications to this section
+         */
+        void adoptAll() {
+            for (auto& entry : keyValues) adopt(entry);
+        }
+
+        /**
+         * @brief Records a modification of a key, queueing it for the journal if the file keeps one
+         * @param key The lowercase key
+         */
+        void markDirty(const std::string& key);
+
+        /**
+         * @brief Forgets all recorded modifications
+         */
+        void markClean() {
+            dirty = false;
+            dirtyKeys.clear();
+            journalKeys.clear();
+            journalQueued = false;
+        }
 
         friend class IniFile;  ///< Allow IniFile to access private members
+        friend class IniValue; ///< Allow values to record their modifications
+    };
+
+    /**
+     * @class IniQuery
+     * @brief Precompiled set of (section, key) lookups, resolved together by IniFile::getMany.
+     *
+     * Names are hashed once, when added, and keys are grouped by section so that
+     * each section is looked up only once per getMany call:
+     *
+     * @code
+     * IniLib::IniQuery query{ { "engine", "power" }, { "engine", "torque" }, { "chassis", "mass" } };
+     * const IniLib::IniValue* values[3];
+     * ini.getMany(query, values);
+     * @endcode
+     */
+    class IniQuery {
+    public:
+        /// @brief Default constructor
+        IniQuery() = default;
+
+        /**
+         * @brief Constructor adding a list of (section, key) pairs, in order
+         * @param entries The pairs to look up
+         */
+        IniQuery(std::initializer_list<std::pair<std::string_view, std::string_view>> entries);
+
+        /**
+         * @brief Adds a lookup
+         * @param section The section to look in
+         * @param key The key to look for
+         * @return size_t Index of the lookup's slot in the getMany output array
+         */
+        size_t add(std::string_view section, std::string_view key);
+
+        /**
+         * @brief Returns the number of lookups, which is the size of the getMany output array
+         * @return size_t Number of lookups
+         */
+        size_t size() const { return count; }
+
+    private:
+        /// @brief A key to look up, with its slot in the output array
+        struct KeyEntry {
+            std::string name; ///< The key name
+            size_t hash;      ///< Case-insensitive hash of the name
+            size_t slot;      ///< Index in the output array
+        };
+
+        /// @brief The keys looked up in one section
+        struct SectionGroup {
+            std::string name;           ///< The section name
+            size_t hash;                ///< Case-insensitive hash of the name
+            std::vector<KeyEntry> keys; ///< Keys to look up in the section
+        };
+
+        std::vector<SectionGroup> groups; ///< Lookups grouped by section, in order of first use
+        size_t count = 0;                 ///< Total number of lookups
+
+        /// @brief Rebuilds an IniKey from a stored name and hash
+        static IniKey makeKey(const std::string& name, size_t hash) { return IniKey(name, hash); }
+
+        friend class IniFile; ///< Allow IniFile to resolve the groups
     };
 
     /**
@@ -360,6 +1215,23 @@ namespace IniLib {
      */
     class IniFile {
     public:
+        using SectionMap = std::unordered_map<std::string, IniSection, IniKeyHash, IniKeyEqual>; ///< Map of sections in the file
+
+        /// @brief Default constructor
+        IniFile() = default;
+
+        /// @brief Copy constructor, binding the copied sections to this file
+        IniFile(const IniFile& other);
+
+        /// @brief Move constructor, binding the moved sections to this file
+        IniFile(IniFile&& other);
+
+        /// @brief Copy assignment, binding the copied sections to this file
+        IniFile& operator=(const IniFile& other);
+
+        /// @brief Move assignment, binding the moved sections to this file
+        IniFile& operator=(IniFile&& other);
+
         /**
          * @brief Loads an INI file from a given path
          * @param filename The path of the INI file to load
@@ -367,12 +1239,214 @@ namespace IniLib {
          */
         bool load(const std::string& filename);
 
+        /**
+         * @brief Loads an INI file from a given path, validating it against a schema while parsing
+         * @param filename The path of the INI file to load
+         * @param schema The schema to validate against
+         * @param violations Receives all schema violations found, the file is loaded regardless
+         * @return true if the file was successfully loaded, false otherwise
+         */
+        bool load(const std::string& filename, const IniSchema& schema, std::vector<IniSchemaViolation>& violations);
+
         /**
          * @brief Saves the current INI configuration to a file
+         *
+         * The whole file is rendered into a single buffer of the exact size and written at once.
+         * With setPreserveFormat(true), the loaded file is written back with its comments, blank
+         * lines, key casing and ordering, and only modified entries are re-rendered. Otherwise,
+         * when threads is greater than 1, sections are split into that many contiguous ranges
+         * rendered concurrently into separate buffers, which are then written in order.
+         *
+         * @param filename The path of the file to save to
+         * @param threads Number of threads to render with
+         * @return true if the file was successfully saved, false otherwise
+         */
+        bool save(const std::string& filename, unsigned threads = 1) const;
+
+        /**
+         * @brief Appends the text save would write to a caller-provided buffer
+         *
+         * The buffer grows at most once, to the exact size needed.
+         *
+         * @param out The buffer to append to
+         */
+        void saveToBuffer(std::string& out) const;
+
+        /**
+         * @brief Returns the text save would write
+         * @return std::string The INI text
+         */
+        std::string saveToString() const;
+
+        /**
+         * @brief Writes the text save would write to a stream
+         * @param out The stream to write to
+         * @param threads Number of threads to render with, as for save
+         * @return true if the stream is still good after writing, false otherwise
+         */
+        bool saveToStream(std::ostream& out, unsigned threads = 1) const;
+
+        /**
+         * @brief Passes the text save would write to a callback, in consecutive chunks
+         *
+         * Sections are rendered one at a time into a reused buffer, so the whole text is
+         * never held in memory unless the layout is preserved. Chunks are only valid
+         * during the call.
+         *
+         * @param sink Callback receiving each chunk
+         */
+        void saveToSink(const std::function<void(std::string_view chunk)>& sink) const;
+
+        /**
+         * @brief Saves the current INI configuration to a file, atomically and durably
+         *
+         * The file is written to a temporary file in the same directory, flushed to disk,
+         * then renamed over the target, and the directory is flushed. After a crash the
+         * target holds either its previous contents or the new ones, never a mix. The
+         * temporary name includes the process id and a counter, so concurrent savers and
+         * leftovers of an earlier crash don't collide.
+         *
          * @param filename The path of the file to save to
          * @return true if the file was successfully saved, false otherwise
          */
-        bool save(const std::string& filename) const;
+        bool saveAtomic(const std::string& filename) const;
+
+        /**
+         * @brief Saves several INI files atomically and durably, grouping the disk flushes
+         *
+         * Each temporary file is written and flushed on its own thread, up to 64 at a time,
+         * so the flushes overlap instead of adding up, and each directory is flushed once
+         * after all renames.
+         * Files are saved with the same guarantees as saveAtomic, but not as a transaction:
+         * if one fails, the others may already have been replaced.
+         *
+         * @param files Pairs of target path and file to save there
+         * @return true if every file was successfully saved, false otherwise
+         */
+        static bool saveAll(const std::vector<std::pair<std::string, const IniFile*>>& files);
+
+        /**
+         * @brief Saves only the sections modified since the file was loaded or last saved with saveChanges
+         *
+         * With setTrackChanges(true), setPreserveFormat(true) or setJournal(true) called before
+         * loading, the loaded text is kept, including comments and formatting, and only modified
+         * entries are re-rendered. Without any of them, the whole file is written every time.
+         * When filename is the path the file was loaded from, the file is patched in place: if
+         * its length is unchanged, only the byte ranges that differ are overwritten, otherwise
+         * only the bytes from the first modified entry onwards are rewritten. If nothing was
+         * modified, no I/O is performed. When filename is a different path, the whole file is
+         * written there, and while the text is kept, filename becomes the path later calls
+         * compare against. The file must not have been changed by other means in between,
+         * including save.
+         *
+         * @param filename The path of the file to save to
+         * @return true if the file was successfully saved or had no changes, false otherwise
+         */
+        bool saveChanges(const std::string& filename);
+
+        /**
+         * @brief Enables or disables an append-only journal of changes next to the loaded file
+         *
+         * The journal is the loaded file's path followed by ".journal". While enabled, set,
+         * removeKey, removeSection, clear and clearSection record their change in it instead
+         * of rewriting the whole file; changes made through references to sections or values
+         * are recorded by appendJournal. load replays the journal on top of the file, so enable
+         * it before loading. saveChanges to the loaded path makes the file complete again and
+         * deletes the journal.
+         *
+         * @param enabled Whether to use the journal
+         * @param compactThreshold Journal size, in bytes, above which appendJournal compacts it
+         */
+        void setJournal(bool enabled, size_t compactThreshold = 1024 * 1024);
+
+        /**
+         * @brief Appends the changes made since the last load, saveChanges or appendJournal to the journal
+         *
+         * One record is written per modified key and removed section, so the cost depends on the
+         * changes and not on the file size. Once the journal is larger than the compaction
+         * threshold, it is compacted with compactJournal. Changes that could not be written stay
+         * pending and are recorded by the next call.
+         *
+         * @return true if the changes were recorded, false if the journal is disabled, no file was loaded or writing failed
+         */
+        bool appendJournal();
+
+        /**
+         * @brief Saves all journaled and pending changes to the loaded file and deletes the journal
+         *
+         * The file is rendered once, keeping the layout of the loaded text, and replaced atomically
+         * with those exact bytes, which become the new loaded text. The journal is deleted only
+         * afterwards, so a crash in between leaves records that replay to the same contents.
+         *
+         * @return true if the file was saved and the journal deleted, false otherwise
+         */
+        bool compactJournal();
+
+        /**
+         * @brief Sets whether the text of the loaded file is kept, so saveChanges only writes what changed
+         *
+         * Keeping the text roughly doubles the memory used by a loaded file, so it is off by
+         * default. It must be enabled before loading. Preserved layouts and the journal keep
+         * the text too, without this setting.
+         *
+         * @param track Whether to keep the loaded text
+         */
+        void setTrackChanges(bool track) { trackChanges = track; }
+
+        /**
+         * @brief Returns whether the text of the loaded file is kept for saveChanges
+         * @return true if the text is kept, false otherwise
+         */
+        bool tracksChanges() const { return trackChanges; }
+
+        /**
+         * @brief Sets whether save keeps the layout of the loaded file
+         *
+         * When enabled, save copies the regions of the loaded file that were not modified
+         * verbatim. It must be enabled before loading, so the loaded text is kept, and has
+         * no effect until a file is loaded into an empty IniFile or written with saveChanges.
+         *
+         * @param preserve Whether to preserve the layout
+         */
+        void setPreserveFormat(bool preserve) { preserveFormat = preserve; }
+
+        /**
+         * @brief Returns whether save keeps the layout of the loaded file
+         * @return true if the layout is preserved, false otherwise
+         */
+        bool preservesFormat() const { return preserveFormat; }
+
+        /**
+         * @brief Sets whether save writes sections and keys sorted by name
+         *
+         * The maps are unordered, so by default the output order depends on the build and the
+         * run. When enabled, sections and keys are written in byte order of their lowercase
+         * names, so the same contents always produce the same file. Combined with
+         * setPreserveFormat(true), loaded entries keep their original order and only added
+         * sections and keys are sorted.
+         *
+         * @param sorted Whether to sort the output
+         */
+        void setSortedOutput(bool sorted) { sortedOutput = sorted; }
+
+        /**
+         * @brief Returns whether save writes sections and keys sorted by name
+         * @return true if the output is sorted, false otherwise
+         */
+        bool sortsOutput() const { return sortedOutput; }
+
+        /**
+         * @brief Checks if the file was modified since it was loaded or last saved with saveChanges
+         * @return true if any section was added, modified or removed, false otherwise
+         */
+        bool isDirty() const;
+
+        /**
+         * @brief Checks if a section was modified since it was loaded or last saved with saveChanges
+         * @param section The section to check
+         * @return true if the section was added, modified or removed, false otherwise
+         */
+        bool isDirty(const std::string& section) const;
 
         /**
          * @brief Retrieves a value for a given section and key
@@ -383,6 +1457,89 @@ namespace IniLib {
          */
         IniValue get(const std::string& section, const std::string& key, const IniValue& defaultValue = IniValue()) const;
 
+        /**
+         * @brief Retrieves a reference to the value for a given section and key, without copying it
+         * @param section The section to look in
+         * @param key The key to look for
+         * @param defaultValue Value to return if the key is not found
+         * @return const IniValue& The value associated with the key, or defaultValue if not found
+         * @note When the key is missing the returned reference is defaultValue itself, so it must outlive the result
+         */
+        const IniValue& getRef(const std::string& section, const std::string& key, const IniValue& defaultValue) const;
+
+        /**
+         * @brief Looks up a section
+         * @param section The section to look for
+         * @return IniSection* Pointer to the section, or nullptr if the section is not found
+         */
+        IniSection* find(const std::string& section);
+
+        /**
+         * @brief Const version of find
+         * @param section The section to look for
+         * @return const IniSection* Pointer to the section, or nullptr if the section is not found
+         */
+        const IniSection* find(const std::string& section) const;
+
+        /**
+         * @brief Looks up the value for a given section and key
+         * @param section The section to look in
+         * @param key The key to look for
+         * @return IniValue* Pointer to the value, or nullptr if the section or key is not found
+         */
+        IniValue* find(const std::string& section, const std::string& key);
+
+        /**
+         * @brief Const version of find
+         * @param section The section to look in
+         * @param key The key to look for
+         * @return const IniValue* Pointer to the value, or nullptr if the section or key is not found
+         */
+        const IniValue* find(const std::string& section, const std::string& key) const;
+
+        /**
+         * @brief Looks up a section by precomputed name, without folding or hashing it
+         * @param section The section to look for
+         * @return IniSection* Pointer to the section, or nullptr if the section is not found
+         */
+        IniSection* find(const IniKey& section);
+
+        /**
+         * @brief Const version of find
+         * @param section The section to look for
+         * @return const IniSection* Pointer to the section, or nullptr if the section is not found
+         */
+        const IniSection* find(const IniKey& section) const;
+
+        /**
+         * @brief Looks up the value for a precomputed section and key
+         * @param section The section to look in
+         * @param key The key to look for
+         * @return IniValue* Pointer to the value, or nullptr if the section or key is not found
+         */
+        IniValue* find(const IniKey& section, const IniKey& key);
+
+        /**
+         * @brief Const version of find
+         * @param section The section to look in
+         * @param key The key to look for
+         * @return const IniValue* Pointer to the value, or nullptr if the section or key is not found
+         */
+        const IniValue* find(const IniKey& section, const IniKey& key) const;
+
+        /**
+         * @brief Resolves every lookup of a query in one pass
+         *
+         * Each section is looked up once, and all names are hashed in advance. Values are
+         * not copied: out receives pointers, valid until the file is modified.
+         *
+         * @param query The lookups to resolve
+         * @param out Array of query.size() pointers, receiving each value in the order it was
+         * added to the query, or nullptr if its section or key is not found
+         * @return size_t Number of values found
+         */
+        size_t getMany(const IniQuery& query, const IniValue** out) const;
+
         /**
          * @brief Sets a value for a given section and key
          * @param section The section to set the value for
@@ -391,6 +1548,27 @@ namespace IniLib {
          */
         void set(const std::string& section, const std::string& key, const IniValue& value);
 
+        /**
+         * @brief Sets a value for a given section and key, taking ownership of the value
+         * @param section The section to set the value for
+         * @param key The key to set the value for
+         * @param value The value to move into the section
+         */
+        void set(const std::string& section, const std::string& key, IniValue&& value);
+
+        /**
+         * @brief Constructs a value in place for a given section and key, replacing any existing value
+         * @tparam Args Types of the IniValue constructor arguments
+         * @param section The section to set the value for
+         * @param key The key to set the value for
+         * @param args Arguments forwarded to the IniValue constructor
+         * @return IniValue& Reference to the stored value
+         */
+        template<typename... Args>
+        IniValue& emplace(const std::string& section, const std::string& key, Args&&... args) {
+            return insertSection(toLower(section)).first->second.emplace(key, std::forward<Args>(args)...);
+        }
+
         /**
          * @brief Adds a section, returns true if the section is newly created, false if it already exists
          * @param section The section to add
@@ -439,6 +1617,14 @@ namespace IniLib {
          */
         bool hasKey(const std::string& section, const std::string& key) const;
 
+        /**
+         * @brief Checks if a precomputed key exists in a precomputed section
+         * @param section The section containing the key
+         * @param key The key to check for
+         * @return true if the key exists, false otherwise
+         */
+        bool hasKey(const IniKey& section, const IniKey& key) const { return find(section, key) != nullptr; }
+
         /**
          * @brief Returns the number of sections in the INI file
          * @return size_t The number of sections
@@ -467,10 +1653,153 @@ namespace IniLib {
          */
         const IniSection& operator[](const std::string& section) const;
 
+        /**
+         * @brief Accesses a section by precomputed name, creates the section if it doesn't exist
+         * @param section The section to access
+         * @return IniSection& Reference to the section
+         */
+        IniSection& operator[](const IniKey& section);
+
+        /**
+         * @brief Const version of subscript operator
+         * @param section The section to access
+         * @return const IniSection& Reference to the section
+         * @throws IniFileException if the section doesn't exist
+         */
+        const IniSection& operator[](const IniKey& section) const;
+
+        /**
+         * @brief Extracts the first value of a key from every section matching a pattern, in one pass
+         *
+         * Sections without the key are skipped. When threads is greater than 1, matching
+         * sections are split into that many contiguous ranges decoded concurrently.
+         *
+         * @tparam T The type to convert the values to.
+         * @param key The key to extract
+         * @param sectionPattern Section name pattern, with * and ? wildcards
+         * @param threads Number of threads to decode with
+         * @return IniColumn<T> The decoded values and the names of their sections
+         * @throws IniValueConvertException if a value is empty or fails to convert.
+         */
+        template<typename T>
+        IniColumn<T> getColumn(const std::string& key, const std::string& sectionPattern = "*", unsigned threads = 1) const {
+            std::string lowerKey = toLower(key), pattern = toLower(sectionPattern);
+            std::vector<const IniValue*> found;
+            IniColumn<T> column;
+            for (const auto& sectionPair : sections) {
+                if (!matchPattern(pattern, sectionPair.first)) continue;
+                auto it = sectionPair.second.keyValues.find(lowerKey);
+                if (it == sectionPair.second.keyValues.end()) continue;
+                found.push_back(&it->second);
+                column.sections.push_back(sectionPair.first);
+            }
+            column.values.resize(found.size());
+
+            // std::vector<bool> packs bits, so concurrent writes to neighbours would race
+            if (std::is_same<T, bool>::value || threads < 2 || found.size() < threads) {
+                for (size_t i = 0; i < found.size(); ++i) {
+                    column.values[i] = found[i]->getAs<T>();
+                }
+                return column;
+            }
+
+            runParallel(found.size(), threads, [&](size_t first, size_t last) {
+                for (size_t i = first; i < last; ++i) {
+                    column.values[i] = found[i]->getAs<T>();
+                }
+            });
+            return column;
+        }
+
+        /**
+         * @brief Extracts the first value of a key from sections matching a pattern into a caller-provided buffer
+         *
+         * Sections without the key are skipped. No allocation is performed besides folding
+         * the key and pattern.
+         *
+         * @tparam T The type to convert the values to.
+         * @param key The key to extract
+         * @param sectionPattern Section name pattern, with * and ? wildcards
+         * @param out Destination buffer for the values
+         * @param n Capacity of the destination buffers, in elements
+         * @param names Optional destination buffer for the section names, or nullptr
+         * @return size_t Number of values written
+         * @throws IniValueConvertException if a value is empty or fails to convert.
+         */
+        template<typename T>
+        size_t getColumnInto(const std::string& key, const std::string& sectionPattern, T* out, size_t n, std::string_view* names = nullptr) const {
+            std::string lowerKey = toLower(key), pattern = toLower(sectionPattern);
+            size_t count = 0;
+            for (const auto& sectionPair : sections) {
+                if (count == n) break;
+                if (!matchPattern(pattern, sectionPair.first)) continue;
+                auto it = sectionPair.second.keyValues.find(lowerKey);
+                if (it == sectionPair.second.keyValues.end()) continue;
+                out[count] = it->second.getAs<T>();
+                if (names) names[count] = sectionPair.first;
+                ++count;
+            }
+            return count;
+        }
+
+        /**
+         * @brief Returns an iterator to the first section
+         * @return SectionMap::const_iterator Iterator over (lowercase section name, section) pairs, in no particular order
+         */
+        SectionMap::const_iterator begin() const { return sections.begin(); }
+
+        /**
+         * @brief Returns an iterator past the last section
+         * @return SectionMap::const_iterator End iterator
+         */
+        SectionMap::const_iterator end() const { return sections.end(); }
+
     private:
-        std::unordered_map<std::string, IniSection> sections; ///< Map of section names and sections
+        /// @brief Byte ranges of a key line in the source text
+        struct EntrySpan {
+            size_t begin;      ///< Offset of the line
+            size_t end;        ///< Offset past the line, including its newline
+            size_t keyBegin;   ///< Offset of the key, as written
+            size_t keyEnd;     ///< Offset past the key
+            size_t valueBegin; ///< Offset of the value
+            size_t valueEnd;   ///< Offset past the value, before any comment
+        };
+
+        /// @brief Byte range of a section in the source text
+        struct SourceSpan {
+            std::string section;            ///< Lowercase section name
+            size_t begin;                   ///< Offset of the header line, or of the file start for keys before any header
+            size_t end;                     ///< Offset of the next header line, or of the file end
+            bool hasHeader;                 ///< Whether the range starts with a section header
+            std::vector<EntrySpan> entries; ///< Key lines in the range, in file order
+        };
+
+        SectionMap sections;                 ///< Map of section names and sections
+        std::string sourcePath;              ///< Path of the file sourceText was read from or written to, empty if none
+        std::string sourceText;              ///< Contents of the file at sourcePath
+        std::vector<SourceSpan> sourceSpans; ///< Sections of sourceText, in file order
+        bool sourceCrlf = false;             ///< Whether the lines of sourceText end with "\r\n"
+        std::unordered_set<std::string> removedSections; ///< Sections removed since the last load or saveChanges
+        bool trackChanges = false;           ///< Whether the loaded text is kept for saveChanges
+        bool preserveFormat = false;         ///< Whether save keeps the layout of the loaded file
+        bool sortedOutput = false;           ///< Whether save writes sections and keys sorted by name
+        bool journalEnabled = false;         ///< Whether changes are journaled next to sourcePath
+        size_t journalThreshold = 0;         ///< Journal size above which appendJournal compacts
+        size_t journalSize = 0;              ///< Current size of the journal
+        std::vector<std::string> journalRemovedSections; ///< Sections removed since the last appendJournal
+        std::vector<std::string> journalSections; ///< Sections with keys modified since the last appendJournal
 
         friend class IniSection; ///< Allow IniSection to access private members
+        friend class IniSchema;  ///< Allow IniSchema to access private members
+        friend class IniSchemaValidator; ///< Allow IniSchemaValidator to access private members
+
+        /**
+         * @brief Loads an INI file, optionally feeding each section and key to a schema validator
+         * @param filename The path of the INI file to load
+         * @param validator The validator to feed, or nullptr
+         * @return true if the file was successfully loaded, false otherwise
+         */
+        bool load(const std::string& filename, IniSchemaValidator* validator);
 
         /**
          * @brief Trims whitespace from both ends of a string
@@ -500,6 +1829,193 @@ namespace IniLib {
          * @return std::vector<std::string> The list of substrings
          */
         static std::vector<std::string> split(const std::string& str, char delimiter);
+
+        /**
+         * @brief Matches a lowercase name against a lowercase pattern with * and ? wildcards
+         * @param pattern The pattern
+         * @param name The name to match
+         * @return true if the name matches the pattern, false otherwise
+         */
+        static bool matchPattern(std::string_view pattern, std::string_view name);
+
+        /**
+         * @brief Runs work over contiguous ranges of [0, count), one range per thread
+         *
+         * A range whose thread cannot be started runs on the calling thread instead. Every
+         * started thread is joined before the first exception thrown by work, if any, is rethrown.
+         *
+         * @tparam F Callable taking the first and past-the-last index of a range
+         * @param count Number of items
+         * @param threads Number of ranges
+         * @param work The work to run on each range
+         */
+        template<typename F>
+        static void runParallel(size_t count, unsigned threads, F&& work) {
+            std::vector<std::thread> workers;
+            workers.reserve(threads);
+            std::vector<std::exception_ptr> errors(threads);
+            size_t chunk = (count + threads - 1) / threads;
+            for (unsigned t = 0; t < threads; ++t) {
+                size_t first = std::min(count, t * chunk), last = std::min(count, first + chunk);
+                auto task = [&work, &errors, t, first, last]() {
+                    try {
+                        work(first, last);
+                    }
+                    catch (...) {
+                        errors[t] = std::current_exception();
+                    }
+                };
+                try {
+                    // Capacity is reserved, so only the thread constructor can throw here
+                    workers.emplace_back(task);
+                }
+                catch (...) {
+                    task();
+                }
+            }
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+            for (const std::exception_ptr& error : errors) {
+                if (error) std::rethrow_exception(error);
+            }
+        }
+
+        /**
+         * @brief Computes the exact size of the text written by save
+         * @return size_t Number of characters
+         */
+        size_t serializedLength() const;
+
+        /**
+         * @brief Renders the text written by save, appending it to a buffer
+         * @param out The buffer to append to
+         */
+        void serialize(std::string& out) const;
+
+        /**
+         * @brief Renders the text written by save on several threads
+         * @param threads Number of threads, each rendering a contiguous range of sections
+         * @return std::vector<std::string> One buffer per range, to be written in order
+         */
+        std::vector<std::string> serializeParallel(unsigned threads) const;
+
+        /**
+         * @brief Renders the text written by save, with the preserved layout if enabled
+         * @param threads Number of threads to render with, when the layout is not preserved
+         * @return std::vector<std::string> Buffers to be written in order
+         */
+        std::vector<std::string> render(unsigned threads) const;
+
+        /**
+         * @brief Checks if save writes the preserved layout
+         * @return true if the layout is preserved and a source text is available, false otherwise
+         */
+        bool rendersPreserved() const { return preserveFormat && !sourcePath.empty(); }
+
+        /**
+         * @brief Checks if the loaded text must be kept
+         * @return true if saveChanges tracking, a preserved layout or the journal is enabled, false otherwise
+         */
+        bool tracksSource() const { return trackChanges || preserveFormat || journalEnabled; }
+
+        /**
+         * @brief Computes the exact size of a single section as written by save
+         * @param name The lowercase section name
+         * @param section The section
+         * @return size_t Number of characters
+         */
+        static size_t sectionLength(const std::string& name, const IniSection& section);
+
+        /**
+         * @brief Lists the sections in the order save writes them, without copying them
+         * @return std::vector<const SectionMap::value_type*> Pointers to the sections, sorted by name if sortedOutput is set
+         */
+        std::vector<const SectionMap::value_type*> orderedSections() const;
+
+        /**
+         * @brief Lists the keys of a section sorted by name, without copying them
+         * @param section The section
+         * @return std::vector<const IniSection::KeyValueMap::value_type*> Pointers to the key-value pairs
+         */
+        static std::vector<const IniSection::KeyValueMap::value_type*> sortedKeys(const IniSection& section);
+
+        /**
+         * @brief Renders a single section as written by save, appending it to a buffer
+         * @param name The lowercase section name
+         * @param section The section
+         * @param out The buffer to append to
+         * @param header Whether to write the section header
+         * @param sorted Whether to write the keys sorted by name
+         */
+        static void serializeSection(const std::string& name, const IniSection& section, std::string& out, bool header = true, bool sorted = false);
+
+        /**
+         * @brief Forgets all recorded modifications, once the file matches sourceText
+         */
+        void markClean();
+
+        /**
+         * @brief Returns the path of the journal of the loaded file
+         * @return std::string The journal path
+         */
+        std::string journalPath() const { return sourcePath + ".journal"; }
+
+        /**
+         * @brief Applies the records of the journal, if any, on top of the loaded file
+         */
+        void replayJournal();
+
+        /**
+         * @brief Forgets the changes queued for the next appendJournal
+         */
+        void clearJournalQueue();
+
+        /**
+         * @brief Returns a section, adding it and binding it to this file if it doesn't exist
+         * @param name The lowercase section name
+         * @return The section and whether it was added
+         */
+        std::pair<SectionMap::iterator, bool> insertSection(std::string name);
+
+        /**
+         * @brief Makes every section report its modifications to this file
+         */
+        void adoptSections();
+
+        /**
+         * @brief Splits INI text into section ranges and key lines
+         * @param text The INI text
+         * @param crlf Receives whether the lines of the text end with "\r\n"
+         * @return std::vector<SourceSpan> The sections, in text order
+         */
+        static std::vector<SourceSpan> scanSource(const std::string& text, bool& crlf);
+
+        /**
+         * @brief Renders the file on top of sourceText, re-rendering only modified keys
+         *
+         * Unmodified regions are copied verbatim in runs that are as long as possible.
+         * Modified values are replaced in their original lines, keeping the key as written
+         * and any comment. Removed keys and sections are dropped, new keys are inserted
+         * after the last key of their section and new sections are appended.
+         *
+         * @param out The buffer to append to
+         */
+        void renderPreserved(std::string& out) const;
     };
 
+    template<typename... Args>
+    IniValue& IniSection::emplace(const std::string& key, Args&&... args) {
+        // try_emplace leaves the arguments untouched when the key already exists
+        auto result = keyValues.try_emplace(IniFile::toLower(key), std::forward<Args>(args)...);
+        if (result.second) {
+            adopt(*result.first);
+            markDirty(result.first->first);
+        }
+        else {
+            result.first->second = IniValue(std::forward<Args>(args)...);
+        }
+        return result.first->second;
+    }
+
 } // namespace IniLib
@@ -0,0 +1,238 @@
+/*
+MIT License
+
+Copyright (c) 2024
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "IniSchema.h"
+#include "IniValueConvert.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+namespace IniLib {
+
+    namespace {
+
+        /**
+         * @brief Parses a floating point number, without throwing
+         * @param str The text to parse
+         * @param result Receives the parsed value
+         * @return true if the whole text is a valid number, false otherwise
+         */
+        bool parseDecimal(std::string_view str, double& result) {
+            if (!str.empty() && str[0] == '+') str.remove_prefix(1);
+            auto parsed = std::from_chars(str.data(), str.data() + str.size(), result);
+            return !str.empty() && parsed.ec == std::errc() && parsed.ptr == str.data() + str.size();
+        }
+
+        std::string formatNumber(double number) {
+            char buffer[32];
+            auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+            return std::string(buffer, result.ptr);
+        }
+
+        const char* typeName(IniSchema::Type type) {
+            switch (type) {
+            case IniSchema::Type::Bool: return "bool";
+            case IniSchema::Type::Char: return "char";
+            case IniSchema::Type::Integer: return "integer";
+            case IniSchema::Type::Decimal: return "decimal";
+            default: return "any";
+            }
+        }
+
+    } // namespace
+
+    // IniSchema class methods
+    void IniSchema::addKey(const std::string& sectionPattern, const std::string& key, Type type, bool required) {
+        addRule(sectionPattern, KeyRule{ IniFile::toLower(key), type, required, false, 0.0, 0.0 });
+    }
+
+    void IniSchema::addKey(const std::string& sectionPattern, const std::string& key, Type type, bool required, double min, double max) {
+        addRule(sectionPattern, KeyRule{ IniFile::toLower(key), type, required, true, min, max });
+    }
+
+    void IniSchema::addRule(const std::string& sectionPattern, KeyRule rule) {
+        std::string pattern = IniFile::toLower(sectionPattern);
+        auto it = std::find_if(sections.begin(), sections.end(), [&](const SectionRules& rules) { return rules.pattern == pattern; });
+        if (it == sections.end()) {
+            SectionRules rules;
+            rules.pattern = pattern;
+            rules.wildcard = pattern.find_first_of("*?") != std::string::npos;
+            sections.push_back(std::move(rules));
+            it = sections.end() - 1;
+        }
+
+        auto existing = it->index.find(rule.key);
+        if (existing != it->index.end()) {
+            it->keys[existing->second] = std::move(rule);
+        }
+        else {
+            it->index.emplace(rule.key, it->keys.size());
+            it->keys.push_back(std::move(rule));
+        }
+    }
+
+    std::vector<IniSchemaViolation> IniSchema::validate(const IniFile& ini) const {
+        std::vector<IniSchemaViolation> violations;
+        IniSchemaValidator validator(*this, violations);
+        for (const auto& sectionPair : ini) {
+            validator.beginSection(sectionPair.first);
+            for (const auto& kv : sectionPair.second) {
+                validator.validateKey(kv.first, kv.second);
+            }
+        }
+        validator.finish();
+        return violations;
+    }
+
+    // IniSchemaValidator class methods
+    IniSchemaValidator::IniSchemaValidator(const IniSchema& schema, std::vector<IniSchemaViolation>& violations)
+        : schema(schema), violations(violations) {}
+
+    void IniSchemaValidator::beginSection(const std::string& section) {
+        auto result = states.try_emplace(section);
+        if (result.second) {
+            for (size_t i = 0; i < schema.sections.size(); ++i) {
+                const IniSchema::SectionRules& rules = schema.sections[i];
+                if (IniFile::matchPattern(rules.pattern, section)) {
+                    result.first->second.rules.push_back(i);
+                    result.first->second.seen.emplace_back(rules.keys.size(), false);
+                }
+            }
+        }
+        currentName = section;
+        current = &result.first->second;
+    }
+
+    void IniSchemaValidator::validateKey(const std::string& key, const IniValue& value) {
+        if (current == nullptr) {
+            beginSection("");
+        }
+        current->keys.emplace_back(&key, &value);
+    }
+
+    void IniSchemaValidator::checkKey(SectionState& state, const std::string& key, const IniValue& value) {
+        bool declared = false;
+        for (size_t r = 0; r < state.rules.size(); ++r) {
+            const IniSchema::SectionRules& rules = schema.sections[state.rules[r]];
+            auto it = rules.index.find(key);
+            if (it == rules.index.end()) continue;
+
+            declared = true;
+            state.seen[r][it->second] = true;
+            const IniSchema::KeyRule& rule = rules.keys[it->second];
+
+            for (std::string_view element : value.getViews()) {
+                bool valid = true;
+                double number = 0.0;
+                switch (rule.type) {
+                case IniSchema::Type::Bool: {
+                    bool flag = false;
+                    valid = parseBool(element, flag);
+                    break;
+                }
+                case IniSchema::Type::Char:
+                    valid = element.size() == 1;
+                    break;
+                case IniSchema::Type::Integer: {
+                    long long integer = 0;
+                    valid = parseInteger(element, integer);
+                    number = static_cast<double>(integer);
+                    break;
+                }
+                case IniSchema::Type::Decimal:
+                    valid = parseDecimal(element, number);
+                    break;
+                default:
+                    break;
+                }
+
+                if (!valid) {
+                    report(IniSchemaViolation::Kind::InvalidType, key,
+                        "Value \"" + std::string(element) + "\" is not a valid " + typeName(rule.type));
+                    break;
+                }
+                // NaN compares false against both bounds, so non-finite values are rejected explicitly
+                if (rule.hasRange && (!std::isfinite(number) || number < rule.min || number > rule.max)) {
+                    report(IniSchemaViolation::Kind::OutOfRange, key,
+                        "Value \"" + std::string(element) + "\" is outside [" + formatNumber(rule.min) + ", " + formatNumber(rule.max) + "]");
+                    break;
+                }
+            }
+        }
+
+        if (!declared && !schema.allowUnknownKeys) {
+            report(IniSchemaViolation::Kind::UnknownKey, key, "Key is not declared by the schema");
+        }
+    }
+
+    void IniSchemaValidator::finish() {
+        // Check sections and keys by name, independently of the hash map and file order
+        std::vector<std::pair<const std::string, SectionState>*> ordered;
+        ordered.reserve(states.size());
+        for (auto& statePair : states) {
+            ordered.push_back(&statePair);
+        }
+        std::sort(ordered.begin(), ordered.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+
+        for (auto* statePair : ordered) {
+            currentName = statePair->first;
+            SectionState& state = statePair->second;
+            // A key read several times was overwritten in place, so only its stored value is checked
+            std::sort(state.keys.begin(), state.keys.end(), [](const auto& a, const auto& b) { return *a.first < *b.first; });
+            state.keys.erase(std::unique(state.keys.begin(), state.keys.end(), [](const auto& a, const auto& b) { return a.first == b.first; }), state.keys.end());
+            for (const auto& keyValue : state.keys) {
+                checkKey(state, *keyValue.first, *keyValue.second);
+            }
+        }
+
+        for (const auto* statePair : ordered) {
+            currentName = statePair->first;
+            const SectionState& state = statePair->second;
+            for (size_t r = 0; r < state.rules.size(); ++r) {
+                const IniSchema::SectionRules& rules = schema.sections[state.rules[r]];
+                for (size_t k = 0; k < rules.keys.size(); ++k) {
+                    if (rules.keys[k].required && !state.seen[r][k]) {
+                        report(IniSchemaViolation::Kind::MissingKey, rules.keys[k].key, "Required key is missing");
+                    }
+                }
+            }
+        }
+
+        for (const IniSchema::SectionRules& rules : schema.sections) {
+            if (rules.wildcard || states.count(rules.pattern)) continue;
+            bool required = std::any_of(rules.keys.begin(), rules.keys.end(), [](const IniSchema::KeyRule& rule) { return rule.required; });
+            if (required) {
+                currentName = rules.pattern;
+                report(IniSchemaViolation::Kind::MissingSection, "", "Required section is missing");
+            }
+        }
+        current = nullptr;
+    }
+
+    void IniSchemaValidator::report(IniSchemaViolation::Kind kind, const std::string& key, const std::string& message) {
+        violations.push_back(IniSchemaViolation{ kind, currentName, key, message });
+    }
+
+} // namespace IniLib
@@ -0,0 +1,204 @@
+/*
+MIT License
+
+Copyright (c) 2024
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "IniLib.h"
+
+namespace IniLib {
+
+    /**
+     * @struct IniSchemaViolation
+     * @brief A single rule violation found while validating an INI file against an IniSchema.
+     */
+    struct IniSchemaViolation {
+        /// @brief Kind of violation
+        enum class Kind {
+            MissingSection, ///< A section without wildcards, declaring required keys, is absent
+            MissingKey,     ///< A required key is absent from a matching section
+            UnknownKey,     ///< A key is not declared for the section, and unknown keys are not allowed
+            InvalidType,    ///< An element of the value does not decode as the declared type
+            OutOfRange      ///< An element of the value is outside the declared numeric range
+        };
+
+        Kind kind;           ///< Kind of violation
+        std::string section; ///< Lowercase section name
+        std::string key;     ///< Lowercase key name, empty for MissingSection
+        std::string message; ///< Human-readable description
+    };
+
+    /**
+     * @class IniSchema
+     * @brief Set of rules describing the sections and keys expected in an INI file.
+     *
+     * Rules are grouped by section pattern as they are added, so validation is a
+     * single traversal of the file with one hash lookup per key and no exceptions.
+     * Section patterns are case-insensitive and may contain * and ? wildcards.
+     */
+    class IniSchema {
+    public:
+        /// @brief Type that every element of a value must decode as
+        enum class Type {
+            Any,     ///< No type check
+            Bool,    ///< true, false, 1 or 0
+            Char,    ///< A single character
+            Integer, ///< Decimal, hexadecimal (0x) or octal (0) integer
+            Decimal  ///< Floating point number
+        };
+
+        /**
+         * @brief Declares a key for all sections matching a pattern
+         * @param sectionPattern Section name, optionally containing * and ? wildcards
+         * @param key The key name
+         * @param type The type every element of the value must decode as
+         * @param required Whether the key must be present in every matching section
+         */
+        void addKey(const std::string& sectionPattern, const std::string& key, Type type, bool required = true);
+
+        /**
+         * @brief Declares a numeric key with an inclusive range for all sections matching a pattern
+         *
+         * Non-finite values, such as nan or inf, are always out of range.
+         *
+         * @param sectionPattern Section name, optionally containing * and ? wildcards
+         * @param key The key name
+         * @param type The type every element of the value must decode as, Integer or Decimal
+         * @param required Whether the key must be present in every matching section
+         * @param min Smallest allowed value
+         * @param max Largest allowed value
+         */
+        void addKey(const std::string& sectionPattern, const std::string& key, Type type, bool required, double min, double max);
+
+        /**
+         * @brief Sets whether keys not declared for a matching section are reported
+         * @param allow true to accept undeclared keys (the default), false to report them
+         */
+        void setAllowUnknownKeys(bool allow) { allowUnknownKeys = allow; }
+
+        /**
+         * @brief Validates a loaded INI file in a single traversal
+         *
+         * Sections and keys are visited by name, so violations are reported in the same
+         * order on every run.
+         *
+         * @param ini The INI file to validate
+         * @return std::vector<IniSchemaViolation> All violations found, empty if the file is valid
+         */
+        std::vector<IniSchemaViolation> validate(const IniFile& ini) const;
+
+    private:
+        /// @brief Declaration of a single key
+        struct KeyRule {
+            std::string key;    ///< Lowercase key name
+            Type type;          ///< Expected element type
+            bool required;      ///< Whether the key must be present
+            bool hasRange;      ///< Whether min and max apply
+            double min;         ///< Smallest allowed value
+            double max;         ///< Largest allowed value
+        };
+
+        /// @brief Rules sharing the same section pattern
+        struct SectionRules {
+            std::string pattern;                                                  ///< Lowercase section pattern
+            bool wildcard;                                                        ///< Whether the pattern contains wildcards
+            std::vector<KeyRule> keys;                                            ///< Declared keys
+            std::unordered_map<std::string, size_t, IniKeyHash, IniKeyEqual> index; ///< Key name to position in keys
+        };
+
+        std::vector<SectionRules> sections; ///< Rules, grouped by section pattern
+        bool allowUnknownKeys = true;       ///< Whether undeclared keys are accepted
+
+        void addRule(const std::string& sectionPattern, KeyRule rule);
+
+        friend class IniSchemaValidator; ///< Allow the validator to access the rules
+    };
+
+    /**
+     * @class IniSchemaValidator
+     * @brief Incremental validation of sections and keys against an IniSchema, as they are read.
+     *
+     * Used by IniSchema::validate and by IniFile::load to validate while parsing,
+     * without a second pass over the file.
+     */
+    class IniSchemaValidator {
+    public:
+        /**
+         * @brief Constructor
+         * @param schema The schema to validate against, which must outlive the validator
+         * @param violations Receives the violations found
+         */
+        IniSchemaValidator(const IniSchema& schema, std::vector<IniSchemaViolation>& violations);
+
+        /**
+         * @brief Starts or resumes a section
+         * @param section The lowercase section name
+         */
+        void beginSection(const std::string& section);
+
+        /**
+         * @brief Adds a key of the current section, checked by finish
+         *
+         * A key added again with the same name and value objects, as load does for keys
+         * repeated in the file, is checked once, with the value it holds at finish.
+         *
+         * @param key The lowercase key name, which must stay valid until finish
+         * @param value The key's value, which must stay valid until finish
+         */
+        void validateKey(const std::string& key, const IniValue& value);
+
+        /**
+         * @brief Checks the added keys and reports missing sections and required keys
+         *
+         * Keys are checked by section name, then by key name. Missing keys are then reported by
+         * section name and in declaration order, and missing sections in declaration order.
+         */
+        void finish();
+
+    private:
+        /// @brief Validation state of one section of the file
+        struct SectionState {
+            std::vector<size_t> rules;           ///< Indices of the matching SectionRules
+            std::vector<std::vector<bool>> seen; ///< Keys found by finish, per matching SectionRules
+            std::vector<std::pair<const std::string*, const IniValue*>> keys; ///< Keys and values added to the section
+        };
+
+        const IniSchema& schema;
+        std::vector<IniSchemaViolation>& violations;
+        std::unordered_map<std::string, SectionState> states; ///< State per section name
+        std::string currentName;                              ///< Name of the current section
+        SectionState* current = nullptr;                      ///< State of the current section
+
+        /**
+         * @brief Checks a key against every rule matching its section
+         * @param state The section state, whose seen flags are updated
+         * @param key The lowercase key name
+         * @param value The key's value
+         */
+        void checkKey(SectionState& state, const std::string& key, const IniValue& value);
+
+        void report(IniSchemaViolation::Kind kind, const std::string& key, const std::string& message);
+    };
+
+} // namespace IniLib
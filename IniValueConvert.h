@@ -30,9 +30,55 @@ SOFTWARE.
 #include <stdexcept>
 #include <typeinfo>
 #include <iomanip>
+#include <string_view>
+#include <charconv>
+#include <limits>
+#include <array>
+#include <utility>
+#include <type_traits>
 
 namespace IniLib {
 
+    /**
+     * @brief Lowercases an ASCII character, consistently with how section and key names are folded
+     * @param c The character to convert
+     * @return char The lowercase character
+     */
+    constexpr char foldKeyChar(char c) {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    /**
+     * @brief Computes the case-insensitive FNV-1a hash of a section or key name
+     *
+     * Usable in constant expressions, so hashes of literal names can be computed at compile time.
+     *
+     * @param name The name to hash
+     * @return size_t The hash of the lowercased name
+     */
+    constexpr size_t hashKey(std::string_view name) {
+        unsigned long long hash = 14695981039346656037ull;
+        for (char c : name) {
+            hash ^= static_cast<unsigned char>(foldKeyChar(c));
+            hash *= 1099511628211ull;
+        }
+        return static_cast<size_t>(hash);
+    }
+
+    /**
+     * @brief Compares two section or key names case-insensitively
+     * @param a The first name
+     * @param b The second name
+     * @return true if the names are equal ignoring case, false otherwise
+     */
+    constexpr bool keyEquals(std::string_view a, std::string_view b) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (foldKeyChar(a[i]) != foldKeyChar(b[i])) return false;
+        }
+        return true;
+    }
+
     /**
      * @class IniValueConvertException
      * @brief Exception thrown when conversion fails in IniValueConvert.
@@ -52,9 +98,12 @@ namespace IniLib {
      *
      * Provides default implementations of `decode` and `encode` that throw
      * `IniValueConvertException`. Specialized implementations are provided for
-     * common types.
+     * common types, all integer widths and enumerations.
+     *
+     * @tparam T The type to convert.
+     * @tparam Enable Used to select partial specializations for families of types.
      */
-    template<typename T>
+    template<typename T, typename Enable = void>
     class IniValueConvert {
     public:
         /**
@@ -80,6 +129,40 @@ namespace IniLib {
 
     // Specialized template implementations for specific types
 
+    /**
+     * @brief Classifies a boolean token with a few byte comparisons.
+     *
+     * Accepts "true", "1", "false" and "0", case-sensitively.
+     *
+     * @param value The text to classify.
+     * @param result Receives the boolean value, untouched on failure.
+     * @return true if the text is a boolean token, false otherwise.
+     */
+    constexpr bool parseBool(std::string_view value, bool& result) {
+        switch (value.size()) {
+        case 1:
+            if (value[0] == '1' || value[0] == '0') {
+                result = value[0] == '1';
+                return true;
+            }
+            return false;
+        case 4:
+            if (value[0] == 't' && value[1] == 'r' && value[2] == 'u' && value[3] == 'e') {
+                result = true;
+                return true;
+            }
+            return false;
+        case 5:
+            if (value[0] == 'f' && value[1] == 'a' && value[2] == 'l' && value[3] == 's' && value[4] == 'e') {
+                result = false;
+                return true;
+            }
+            return false;
+        default:
+            return false;
+        }
+    }
+
     template<>
     class IniValueConvert<bool> {
     public:
@@ -90,9 +173,19 @@ namespace IniLib {
          * @throws IniValueConvertException if the value is not a valid boolean.
          */
         static bool decode(const std::string& value) {
-            if (value == "true" || value == "1") return true;
-            if (value == "false" || value == "0") return false;
-            throw IniValueConvertException("Invalid boolean value: " + value);
+            bool result = false;
+            if (!parseBool(value, result)) throw IniValueConvertException("Invalid boolean value: " + value);
+            return result;
+        }
+
+        /**
+         * @brief Decodes a string into a boolean, without throwing.
+         * @param value The string to decode.
+         * @param result Receives the decoded value.
+         * @return true if the conversion succeeded, false otherwise.
+         */
+        static bool tryDecode(std::string_view value, bool& result) {
+            return parseBool(value, result);
         }
 
         /**
@@ -119,6 +212,18 @@ namespace IniLib {
             return value[0];
         }
 
+        /**
+         * @brief Decodes a string into a char, without throwing.
+         * @param value The string to decode.
+         * @param result Receives the decoded value.
+         * @return true if the string is exactly one character long, false otherwise.
+         */
+        static bool tryDecode(std::string_view value, char& result) {
+            if (value.size() != 1) return false;
+            result = value[0];
+            return true;
+        }
+
         /**
          * @brief Encodes a char into a string.
          * @param value The char value to encode.
@@ -129,99 +234,126 @@ namespace IniLib {
         }
     };
 
-    template<>
-    class IniValueConvert<short> {
-    public:
-        /**
-         * @brief Decodes a string into a short.
-         * @param value The string to decode.
-         * @return short The decoded short value.
-         * @throws IniValueConvertException if the conversion fails.
-         */
-        static short decode(const std::string& value) {
-            try {
-                size_t idx;
-                int result = std::stoi(value, &idx, 0); // Detect decimal or hexadecimal
-                if (idx != value.size()) throw std::invalid_argument("extra characters");
-                return static_cast<short>(result);
-            }
-            catch (...) {
-                throw IniValueConvertException("Invalid short value: " + value);
-            }
+    /**
+     * @brief Parses an integer without allocating or throwing.
+     *
+     * Accepts an optional sign followed by decimal digits, hexadecimal digits
+     * prefixed by 0x, or octal digits prefixed by 0.
+     *
+     * @tparam T The integer type to parse into.
+     * @param value The text to parse.
+     * @param result Receives the parsed value, untouched on failure.
+     * @return true if the whole text is an integer representable by T, false otherwise.
+     */
+    template<typename T>
+    bool parseInteger(std::string_view value, T& result) {
+        bool negative = false;
+        if (!value.empty() && (value[0] == '-' || value[0] == '+')) {
+            negative = value[0] == '-';
+            value.remove_prefix(1);
+        }
+        int base = 10;
+        if (value.size() > 2 && value[0] == '0' && (value[1] == 'x' || value[1] == 'X')) {
+            base = 16;
+            value.remove_prefix(2);
+        }
+        else if (value.size() > 1 && value[0] == '0') {
+            base = 8;
+            value.remove_prefix(1);
         }
 
-        /**
-         * @brief Encodes a short into a string.
-         * @param value The short value to encode.
-         * @return std::string The encoded string.
-         */
-        static std::string encode(const short& value) {
-            return std::to_string(value);
+        unsigned long long magnitude = 0;
+        auto parsed = std::from_chars(value.data(), value.data() + value.size(), magnitude, base);
+        if (value.empty() || parsed.ec != std::errc() || parsed.ptr != value.data() + value.size()) return false;
+
+        constexpr unsigned long long max = static_cast<unsigned long long>(std::numeric_limits<T>::max());
+        if (!negative) {
+            if (magnitude > max) return false;
+            result = static_cast<T>(magnitude);
         }
-    };
+        else if constexpr (std::is_unsigned<T>::value) {
+            if (magnitude != 0) return false;
+            result = 0;
+        }
+        else {
+            if (magnitude > max + 1) return false;
+            result = static_cast<T>(static_cast<long long>(0ull - magnitude));
+        }
+        return true;
+    }
 
-    template<>
-    class IniValueConvert<int> {
+    /**
+     * @class IniIntegerConvert
+     * @brief Range-checked conversion between strings and an integer type.
+     *
+     * Base of the IniValueConvert specializations for all integer widths.
+     * Values that don't fit the target type are rejected rather than truncated.
+     *
+     * @tparam T The integer type.
+     */
+    template<typename T>
+    class IniIntegerConvert {
     public:
         /**
-         * @brief Decodes a string into an int (supports decimal and hexadecimal).
+         * @brief Decodes a string into an integer (supports decimal, hexadecimal and octal).
          * @param value The string to decode.
-         * @return int The decoded int value.
-         * @throws IniValueConvertException if the conversion fails.
+         * @return T The decoded value.
+         * @throws IniValueConvertException if the value is not an integer or is out of range for T.
          */
-        static int decode(const std::string& value) {
-            try {
-                size_t idx;
-                int result = std::stoi(value, &idx, 0); // Detect decimal or hexadecimal
-                if (idx != value.size()) throw std::invalid_argument("extra characters");
-                return result;
-            }
-            catch (...) {
-                throw IniValueConvertException("Invalid int value: " + value);
+        static T decode(const std::string& value) {
+            T result;
+            if (!parseInteger(value, result)) {
+                throw IniValueConvertException("Invalid " + std::string(typeName()) + " value: " + value);
             }
+            return result;
         }
 
         /**
-         * @brief Encodes an int into a string.
-         * @param value The int value to encode.
-         * @return std::string The encoded string.
-         */
-        static std::string encode(const int& value) {
-            return std::to_string(value);
-        }
-    };
-
-    template<>
-    class IniValueConvert<long> {
-    public:
-        /**
-         * @brief Decodes a string into a long (supports decimal and hexadecimal).
+         * @brief Decodes a string into an integer, without throwing.
          * @param value The string to decode.
-         * @return long The decoded long value.
-         * @throws IniValueConvertException if the conversion fails.
+         * @param result Receives the decoded value.
+         * @return true if the conversion succeeded, false otherwise.
          */
-        static long decode(const std::string& value) {
-            try {
-                size_t idx;
-                long result = std::stol(value, &idx, 0); // Detect decimal or hexadecimal
-                if (idx != value.size()) throw std::invalid_argument("extra characters");
-                return result;
-            }
-            catch (...) {
-                throw IniValueConvertException("Invalid long value: " + value);
-            }
+        static bool tryDecode(std::string_view value, T& result) {
+            return parseInteger(value, result);
         }
 
         /**
-         * @brief Encodes a long into a string.
-         * @param value The long value to encode.
+         * @brief Encodes an integer into a string.
+         * @param value The value to encode.
          * @return std::string The encoded string.
          */
-        static std::string encode(const long& value) {
+        static std::string encode(const T& value) {
             return std::to_string(value);
         }
+
+    private:
+        static constexpr const char* typeName() {
+            if constexpr (std::is_same<T, signed char>::value) return "signed char";
+            else if constexpr (std::is_same<T, unsigned char>::value) return "unsigned char";
+            else if constexpr (std::is_same<T, short>::value) return "short";
+            else if constexpr (std::is_same<T, unsigned short>::value) return "unsigned short";
+            else if constexpr (std::is_same<T, int>::value) return "int";
+            else if constexpr (std::is_same<T, unsigned int>::value) return "unsigned int";
+            else if constexpr (std::is_same<T, long>::value) return "long";
+            else if constexpr (std::is_same<T, unsigned long>::value) return "unsigned long";
+            else if constexpr (std::is_same<T, long long>::value) return "long long";
+            else return "unsigned long long";
+        }
     };
 
+    // Integer specializations; signed char and unsigned char (int8_t, uint8_t) are read as numbers, not characters
+    template<> class IniValueConvert<signed char> : public IniIntegerConvert<signed char> {};
+    template<> class IniValueConvert<unsigned char> : public IniIntegerConvert<unsigned char> {};
+    template<> class IniValueConvert<short> : public IniIntegerConvert<short> {};
+    template<> class IniValueConvert<unsigned short> : public IniIntegerConvert<unsigned short> {};
+    template<> class IniValueConvert<int> : public IniIntegerConvert<int> {};
+    template<> class IniValueConvert<unsigned int> : public IniIntegerConvert<unsigned int> {};
+    template<> class IniValueConvert<long> : public IniIntegerConvert<long> {};
+    template<> class IniValueConvert<unsigned long> : public IniIntegerConvert<unsigned long> {};
+    template<> class IniValueConvert<long long> : public IniIntegerConvert<long long> {};
+    template<> class IniValueConvert<unsigned long long> : public IniIntegerConvert<unsigned long long> {};
+
     template<>
     class IniValueConvert<float> {
     public:
@@ -322,4 +454,148 @@ namespace IniLib {
         }
     };
 
+    /// @brief Detects whether IniValueConvert<T> provides a non-throwing tryDecode
+    template<typename T, typename = void>
+    struct HasTryDecode : std::false_type {};
+
+    /// @brief Detects whether IniValueConvert<T> provides a non-throwing tryDecode
+    template<typename T>
+    struct HasTryDecode<T, std::void_t<decltype(IniValueConvert<T>::tryDecode(std::string_view(), std::declval<T&>()))>> : std::true_type {};
+
+    /**
+     * @brief Whether IniValue may keep a T in native form and encode it on demand.
+     *
+     * Only types whose text round trip is exact qualify, so that decoding the stored value
+     * yields the same result as decoding its text. Floating point values are encoded eagerly.
+     */
+    template<typename T, typename = void>
+    struct IniNativeStorable : std::bool_constant<std::is_integral<T>::value || std::is_enum<T>::value> {};
+
+    /**
+     * @struct IniEnumNames
+     * @brief Trait mapping the names of an enumeration to its values.
+     *
+     * Specialize it to have IniValueConvert read and write an enumeration by name:
+     *
+     * @code
+     * template<>
+     * struct IniLib::IniEnumNames<Weather> {
+     *     static constexpr std::array<std::pair<std::string_view, Weather>, 2> names = { {
+     *         { "dry", Weather::Dry },
+     *         { "wet", Weather::Wet } } };
+     * };
+     * @endcode
+     *
+     * Enumerations without names are converted as their underlying integer.
+     *
+     * @tparam E The enumeration type.
+     */
+    template<typename E>
+    struct IniEnumNames;
+
+    /**
+     * @class IniEnumTable
+     * @brief Open-addressing hash table from enumeration names to their index, built at compile time.
+     * @tparam N Number of names.
+     */
+    template<size_t N>
+    class IniEnumTable {
+    public:
+        /**
+         * @brief Builds the table
+         * @tparam E The enumeration type.
+         * @param names The names and values of the enumeration
+         */
+        template<typename E>
+        constexpr IniEnumTable(const std::array<std::pair<std::string_view, E>, N>& names) : slots() {
+            for (size_t i = 0; i < N; ++i) {
+                size_t slot = hashKey(names[i].first) & (capacity - 1);
+                while (slots[slot] != 0) slot = (slot + 1) & (capacity - 1);
+                slots[slot] = i + 1;
+            }
+        }
+
+        /**
+         * @brief Looks up a name, case-insensitively
+         * @tparam E The enumeration type.
+         * @param names The names and values the table was built from
+         * @param name The name to look up
+         * @return size_t Index of the name, or N if not found
+         */
+        template<typename E>
+        constexpr size_t find(const std::array<std::pair<std::string_view, E>, N>& names, std::string_view name) const {
+            for (size_t slot = hashKey(name) & (capacity - 1); slots[slot] != 0; slot = (slot + 1) & (capacity - 1)) {
+                if (keyEquals(names[slots[slot] - 1].first, name)) return slots[slot] - 1;
+            }
+            return N;
+        }
+
+    private:
+        /// @brief Smallest power of two holding the names at a load factor of at most 1/2
+        static constexpr size_t capacity = [] { size_t c = 1; while (c < 2 * N) c *= 2; return c; }();
+
+        std::array<size_t, capacity> slots; ///< Index + 1 of the name in each slot, 0 if empty
+    };
+
+    /// @brief Detects whether an enumeration has an IniEnumNames specialization
+    template<typename E, typename = void>
+    struct HasEnumNames : std::false_type {};
+
+    /// @brief Detects whether an enumeration has an IniEnumNames specialization
+    template<typename E>
+    struct HasEnumNames<E, std::void_t<decltype(IniEnumNames<E>::names)>> : std::true_type {};
+
+    /**
+     * @class IniValueConvert
+     * @brief Partial specialization for enumerations.
+     *
+     * Enumerations with an IniEnumNames specialization are read by name, using a hash
+     * table built at compile time, or by underlying value. Others are read and written
+     * as their underlying integer.
+     */
+    template<typename T>
+    class IniValueConvert<T, std::enable_if_t<std::is_enum<T>::value>> {
+    public:
+        /**
+         * @brief Decodes a string into an enumeration value.
+         * @param value The string to decode, a name or an underlying value.
+         * @return T The decoded value.
+         * @throws IniValueConvertException if the value is neither a known name nor a valid integer.
+         */
+        static T decode(const std::string& value) {
+            if constexpr (HasEnumNames<T>::value) {
+                constexpr auto& names = IniEnumNames<T>::names;
+                size_t index = table.find(names, value);
+                if (index < names.size()) return names[index].second;
+            }
+            std::underlying_type_t<T> result;
+            if (!parseInteger(value, result)) {
+                throw IniValueConvertException("Invalid enum value: " + value);
+            }
+            return static_cast<T>(result);
+        }
+
+        /**
+         * @brief Encodes an enumeration value into a string.
+         * @param value The value to encode.
+         * @return std::string Its name, or its underlying value if it has no name.
+         */
+        static std::string encode(const T& value) {
+            if constexpr (HasEnumNames<T>::value) {
+                for (const auto& name : IniEnumNames<T>::names) {
+                    if (name.second == value) return std::string(name.first);
+                }
+            }
+            return std::to_string(static_cast<std::underlying_type_t<T>>(value));
+        }
+
+    private:
+        static constexpr auto makeTable() {
+            if constexpr (HasEnumNames<T>::value) return IniEnumTable<IniEnumNames<T>::names.size()>(IniEnumNames<T>::names);
+            else return 0;
+        }
+
+        static constexpr auto table = makeTable(); ///< Name lookup table, built at compile time
+    };
+
 } // namespace IniLib
@@ -0,0 +1,106 @@
+/*
+MIT License
+
+Copyright (c) 2024
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+
+#include "IniWriter.h"
+#include <cctype>
+
+namespace IniLib {
+
+    IniWriter::IniWriter(const std::string& filename, size_t bufferSize) : file(filename), out(&file), bufferSize(bufferSize) {
+        buffer.reserve(bufferSize);
+    }
+
+    IniWriter::IniWriter(std::ostream& out, size_t bufferSize) : out(&out), bufferSize(bufferSize) {
+        buffer.reserve(bufferSize);
+    }
+
+    IniWriter::~IniWriter() {
+        if (!finished) finish();
+    }
+
+    bool IniWriter::isOpen() const {
+        return out != &file || file.is_open();
+    }
+
+    void IniWriter::beginSection(std::string_view name) {
+        if (finished) throw IniFileException("IniWriter is already finished");
+        if (inSection) buffer += '\n';
+        buffer += '[';
+        appendName(name);
+        buffer.append("]\n", 2);
+        inSection = true;
+        if (buffer.size() >= bufferSize) flush();
+    }
+
+    void IniWriter::writeKey(std::string_view key, std::string_view value) {
+        beginKey(key);
+        buffer.append(value);
+        endKey();
+    }
+
+    void IniWriter::writeKey(std::string_view key, const IniValue& value) {
+        beginKey(key);
+        value.appendString(buffer);
+        endKey();
+    }
+
+    bool IniWriter::finish() {
+        if (!finished) {
+            if (inSection) buffer += '\n';
+            flush();
+            out->flush();
+            finished = true;
+        }
+        return isOpen() && out->good();
+    }
+
+    void IniWriter::beginKey(std::string_view key) {
+        if (finished) throw IniFileException("IniWriter is already finished");
+        if (!inSection) throw IniFileException("No section was begun before key \"" + std::string(key) + "\"");
+        appendName(key);
+        buffer += '=';
+    }
+
+    void IniWriter::endKey() {
+        buffer += '\n';
+        if (buffer.size() >= bufferSize) flush();
+    }
+
+    void IniWriter::appendName(std::string_view name) {
+        // Same folding as IniFile, so names match what save writes
+        for (char c : name) {
+            buffer += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+    }
+
+    void IniWriter::flush() {
+        if (!buffer.empty()) {
+            out->write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+
+} // namespace IniLib
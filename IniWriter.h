@@ -0,0 +1,212 @@
+/*
+MIT License
+
+Copyright (c) 2024
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+
+#pragma once
+
+#include "IniLib.h"
+#include <fstream>
+#include <charconv>
+
+namespace IniLib {
+
+    /**
+     * @class IniWriter
+     * @brief Writes an INI file section by section, without building an IniFile in memory.
+     *
+     * Output uses the same formatting as IniFile::save: lowercase section and key names,
+     * "key=value" lines with multiple values joined by ", ", and a blank line after each
+     * section. Text is collected in a buffer of bounded size and written in large batches.
+     * Sections and keys are written in call order and duplicates are not merged.
+     *
+     * @code
+     * IniLib::IniWriter writer("export.ini");
+     * writer.beginSection("car");
+     * writer.writeKey("power", 500);
+     * writer.writeKey("gears", { 3.2, 2.1, 1.4 });
+     * writer.finish();
+     * @endcode
+     */
+    class IniWriter {
+    public:
+        /**
+         * @brief Constructor creating or truncating a file
+         * @param filename The path of the file to write
+         * @param bufferSize Number of characters collected before each write
+         */
+        explicit IniWriter(const std::string& filename, size_t bufferSize = 64 * 1024);
+
+        /**
+         * @brief Constructor writing to a stream
+         * @param out The stream to write to, which must outlive the writer
+         * @param bufferSize Number of characters collected before each write
+         */
+        explicit IniWriter(std::ostream& out, size_t bufferSize = 64 * 1024);
+
+        /// @brief Destructor finishing the output, if finish was not called
+        ~IniWriter();
+
+        IniWriter(const IniWriter&) = delete;
+        IniWriter& operator=(const IniWriter&) = delete;
+
+        /**
+         * @brief Checks if the output was opened successfully
+         * @return true if the output is open, false otherwise
+         */
+        bool isOpen() const;
+
+        /**
+         * @brief Ends the current section, if any, and begins a new one
+         * @param name The section name
+         * @throws IniFileException if the writer is finished
+         */
+        void beginSection(std::string_view name);
+
+        /**
+         * @brief Writes a key with a value given as text
+         * @param key The key name
+         * @param value The value, written as is
+         * @throws IniFileException if no section was begun or the writer is finished
+         */
+        void writeKey(std::string_view key, std::string_view value);
+
+        /// @brief Writes a key with a value given as text
+        void writeKey(std::string_view key, const char* value) { writeKey(key, std::string_view(value)); }
+
+        /// @brief Writes a key with a value given as text
+        void writeKey(std::string_view key, const std::string& value) { writeKey(key, std::string_view(value)); }
+
+        /**
+         * @brief Writes a key with all elements of an IniValue
+         * @param key The key name
+         * @param value The value
+         * @throws IniFileException if no section was begun or the writer is finished
+         */
+        void writeKey(std::string_view key, const IniValue& value);
+
+        /**
+         * @brief Writes a key with a single value of type T
+         * @tparam T The type of the value, encoded with IniValueConvert<T>
+         * @param key The key name
+         * @param value The value
+         * @throws IniFileException if no section was begun or the writer is finished
+         */
+        template<typename T>
+        void writeKey(std::string_view key, const T& value) {
+            beginKey(key);
+            appendValue(value);
+            endKey();
+        }
+
+        /**
+         * @brief Writes a key with a range of values of type T
+         * @tparam InputIt The iterator type
+         * @param key The key name
+         * @param first Iterator to the first value
+         * @param last Iterator past the last value
+         * @throws IniFileException if no section was begun or the writer is finished
+         */
+        template<typename InputIt>
+        void writeKey(std::string_view key, InputIt first, InputIt last) {
+            beginKey(key);
+            for (bool separator = false; first != last; ++first, separator = true) {
+                if (separator) buffer.append(", ", 2);
+                appendValue(*first);
+            }
+            endKey();
+        }
+
+        /// @brief Writes a key with a vector of values of type T
+        template<typename T>
+        void writeKey(std::string_view key, const std::vector<T>& values) { writeKey(key, values.begin(), values.end()); }
+
+        /// @brief Writes a key with a list of values of type T
+        template<typename T>
+        void writeKey(std::string_view key, std::initializer_list<T> values) { writeKey(key, values.begin(), values.end()); }
+
+        /**
+         * @brief Ends the current section and writes any buffered text
+         *
+         * Called by the destructor if needed. No more sections or keys can be written afterwards.
+         *
+         * @return true if all text was written successfully, false otherwise
+         */
+        bool finish();
+
+    private:
+        std::ofstream file;      ///< The file, when constructed from a path
+        std::ostream* out;       ///< The output stream
+        std::string buffer;      ///< Text not yet written
+        size_t bufferSize;       ///< Buffer length that triggers a write
+        bool inSection = false;  ///< Whether a section was begun
+        bool finished = false;   ///< Whether finish was called
+
+        /**
+         * @brief Writes "key=" after checking the writer state
+         * @param key The key name
+         */
+        void beginKey(std::string_view key);
+
+        /**
+         * @brief Ends the key line, writing the buffer if it is full
+         */
+        void endKey();
+
+        /**
+         * @brief Appends a lowercase name
+         * @param name The name
+         */
+        void appendName(std::string_view name);
+
+        /**
+         * @brief Writes the buffered text to the output
+         */
+        void flush();
+
+        /**
+         * @brief Encodes a value into the buffer
+         *
+         * Integers are formatted in place, other types with IniValueConvert<T>::encode.
+         *
+         * @tparam T The type of the value
+         * @param value The value
+         */
+        template<typename T>
+        void appendValue(const T& value) {
+            if constexpr (std::is_base_of<IniIntegerConvert<T>, IniValueConvert<T>>::value) {
+                char digits[24];
+                std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+                buffer.append(digits, result.ptr);
+            }
+            else if constexpr (std::is_convertible<const T&, std::string_view>::value) {
+                buffer.append(std::string_view(value));
+            }
+            else {
+                buffer += IniValueConvert<T>::encode(value);
+            }
+        }
+    };
+
+} // namespace IniLib
@@ -1,17 +1,791 @@
 #include "../IniLib.h"
+#include "../IniBinding.h"
+#include "../IniSchema.h"
+#include "../IniFixed.h"
+#include "../IniWriter.h"
+#include "../Tools/IniGen/IniGenNames.h"
 #include <iostream>
+#include <sstream>
+#include <fstream>
+#include <filesystem>
+#include <iterator>
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <algorithm>
 
 using namespace std;
+using namespace IniLib::literals;
+
+// Struct bound to the keys of a section
+struct TypeSection {
+    int intKey = 0;
+    float floatKey = 0.0f;
+    vector<short> shortKey;
+};
+
+template<>
+struct IniLib::IniBinding<TypeSection> {
+    static constexpr auto fields = std::make_tuple(
+        IniLib::bindField("intKey", &TypeSection::intKey),
+        IniLib::bindField("floatKey", &TypeSection::floatKey),
+        IniLib::bindField("shortKey", &TypeSection::shortKey));
+};
+
+// Enumeration read and written by name
+enum class Weather { Sunny, Rainy };
+
+template<>
+struct IniLib::IniEnumNames<Weather> {
+    static constexpr std::array<std::pair<std::string_view, Weather>, 2> names = { {
+        { "sunny", Weather::Sunny },
+        { "rainy", Weather::Rainy } } };
+};
+
+// Enumeration read and written by value
+enum class Level : uint8_t {};
+
+// Number of failed checks, reported in the exit code
+static int failures = 0;
+
+// Reports a failed expectation and carries on with the remaining checks
+static void check(bool condition, const char* expectation) {
+    if (!condition) {
+        cerr << "Check failed: " << expectation << endl;
+        ++failures;
+    }
+}
+
+// Checks that work() throws an exception of type E
+template<typename E, typename F>
+static void checkThrows(F work, const char* expectation) {
+    try {
+        work();
+    }
+    catch (const E&) {
+        return;
+    }
+    catch (...) {
+    }
+    check(false, expectation);
+}
+
+// Path of a scratch file in the temporary directory
+static string tempFile(const string& name) {
+    return (filesystem::temp_directory_path() / name).string();
+}
+
+// Contents of a file, read in text mode like save writes it
+static string readFile(const string& path) {
+    ifstream file(path);
+    return string(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+}
+
+static void checkDecodeInto() {
+    IniLib::IniValue value({ "1", "2", "x", "4" });
+
+    int buffer[4] = { -1, -1, -1, -1 };
+    IniLib::DecodeResult result = value.decodeInto(buffer, 4);
+    check(result.count == 2 && !result.success, "decodeInto stops at the first invalid element");
+    check(buffer[0] == 1 && buffer[1] == 2 && buffer[2] == -1, "decodeInto leaves the remaining output untouched");
+
+    IniLib::IniValue numbers({ "5", "6", "7" });
+    int small[2] = {};
+    result = numbers.decodeInto(small, 2);
+    check(result.count == 2 && result.success && small[1] == 6, "decodeInto respects the buffer capacity");
+
+    vector<long> decoded;
+    result = numbers.decodeInto<long>(back_inserter(decoded));
+    check(result.success && decoded == vector<long>({ 5, 6, 7 }), "decodeInto fills an output iterator");
+}
+
+static void checkArrayAs() {
+    IniLib::IniValue value({ "3", "1", "4" });
+    IniLib::IniArray<int> array = value.getArrayAs<int>();
+    check(array.size() == 3 && array[0] == 3 && array[2] == 4, "getArrayAs returns every element with its size");
+
+    IniLib::IniArray<int> moved = std::move(array);
+    check(moved.size() == 3 && array.empty(), "IniArray transfers ownership on move");
+
+    check(IniLib::IniValue().getArrayAs<int>().empty(), "getArrayAs of an empty value is empty");
+    checkThrows<IniLib::IniValueConvertException>([] { IniLib::IniValue({ "1", "a" }).getArrayAs<int>(); },
+        "getArrayAs throws on an invalid element");
+}
+
+static void checkViews() {
+    IniLib::IniValue value({ "alpha", "beta" });
+    check(value.getView() == "alpha" && value.getView(1) == "beta", "getView returns the element at the index");
+    checkThrows<IniLib::IniFileException>([&] { value.getView(2); }, "getView throws past the last element");
+
+    vector<string_view> views(value.getViews().begin(), value.getViews().end());
+    check(views.size() == 2 && views[1] == "beta", "getViews visits every element");
+    check(views[0].data() == value.getView(0).data(), "getViews does not copy the elements");
+
+    string joined = "[";
+    value.appendString(joined);
+    check(joined == "[alpha, beta" && value.stringLength() == value.getString().size(), "appendString and stringLength match getString");
+}
+
+static void checkMoveSet() {
+    string text(64, 'x');
+    const char* storage = text.data();
+    IniLib::IniValue value(std::move(text));
+    check(value.getView().data() == storage, "IniValue takes over a moved string without copying it");
+
+    IniLib::IniSection section;
+    IniLib::IniValue moved({ "1", "2" });
+    section.set("Key", std::move(moved));
+    check(section.get("key").getVector() == vector<string>({ "1", "2" }), "set stores a moved value");
+
+    section.emplace("key", vector<string>({ "3" }));
+    check(section.get("key").getString() == "3", "emplace replaces an existing value");
+    section.emplace("other", "4");
+    check(section.keyCount() == 2 && section.get("OTHER").getString() == "4", "emplace adds a new key");
+}
+
+static void checkFind() {
+    IniLib::IniFile file;
+    file.set("Section", "Key", "value");
+
+    IniLib::IniValue* found = file.find("SECTION", "key");
+    check(found != nullptr && found->getString() == "value", "find looks keys up case-insensitively");
+    check(file.find("section", "missing") == nullptr && file.find("missing") == nullptr, "find returns null for missing entries");
+
+    *found = "changed";
+    check(file.get("section", "key").getString() == "changed", "find returns the stored value, not a copy");
+
+    const IniLib::IniFile& constFile = file;
+    const IniLib::IniValue fallback("fallback");
+    check(&constFile.getRef("section", "key", fallback) == constFile.find("section", "key"), "getRef refers to the stored value");
+    check(&constFile.getRef("section", "missing", fallback) == &fallback, "getRef returns the default for missing keys");
+}
+
+static void checkBinding() {
+    IniLib::IniSection section;
+    section.set("IntKey", "12");
+    section.set("shortKey", { "1", "2", "3" });
+    section.set("unbound", "ignored");
+
+    TypeSection decoded;
+    decoded.floatKey = 2.5f;
+    size_t count = IniLib::decodeSection(section, decoded);
+    check(count == 2 && decoded.intKey == 12 && decoded.shortKey == vector<short>({ 1, 2, 3 }), "decodeSection fills the bound members");
+    check(decoded.floatKey == 2.5f, "decodeSection leaves members without a key untouched");
+
+    IniLib::IniSection encoded;
+    IniLib::encodeSection(decoded, encoded);
+    TypeSection roundTrip;
+    IniLib::decodeSection(encoded, roundTrip);
+    check(roundTrip.intKey == 12 && roundTrip.floatKey == 2.5f && roundTrip.shortKey == decoded.shortKey, "encodeSection round-trips through decodeSection");
+
+    section.set("intKey", "twelve");
+    checkThrows<IniLib::IniValueConvertException>([&] { IniLib::decodeSection(section, decoded); }, "decodeSection throws on an invalid value");
+}
+
+static void checkKeyLiterals() {
+    static_assert("MixedCase"_key.hash() == "mixedcase"_key.hash(), "_key hashes case-insensitively at compile time");
+    check("MixedCase"_key.hash() == IniLib::hashKey(string("mixedcase")), "_key hashes like the stored lowercase names");
+
+    IniLib::IniFile file;
+    file.set("Section", "MixedCase", "1");
+    check(file.find("SECTION"_key, "mixedCASE"_key) != nullptr, "_key lookups ignore case");
+    check(!file.hasKey("section"_key, "mixedcas"_key), "_key lookups do not match prefixes");
+    check(file["section"_key]["mixedcase"_key].getString() == "1", "_key subscripts find existing keys");
+}
+
+static void checkGeneratorNames() {
+    check(IniGen::toIdentifier("max-speed") == "max_speed" && IniGen::toIdentifier("class") == "class_" && IniGen::toIdentifier("1st") == "_1st",
+        "toIdentifier replaces invalid characters and avoids keywords");
+
+    vector<IniGen::Section> sections(3);
+    sections[0].name = "a b";
+    sections[1].name = "a_b";
+    sections[2].name = "decode";
+    sections[1].members = { { "max-speed", "", "int" }, { "max_speed", "", "int" }, { "A_b", "", "int" } };
+    vector<string> renamed = IniGen::assignNames(sections, "Config");
+
+    check(sections[1].identifier == "a_b" && sections[0].identifier == "a_b_2", "Sections already named as identifiers keep their name");
+    check(sections[1].type != sections[0].type, "Colliding struct names are made unique");
+    check(sections[2].identifier != "decode", "Section members do not hide the decode function");
+
+    const vector<IniGen::Member>& members = sections[1].members;
+    check(members[1].identifier == "max_speed" && members[0].identifier == "max_speed_2", "Converted keys are suffixed instead of exact ones");
+    check(members[2].identifier != sections[1].type, "Members are not named like their struct");
+    check(renamed.size() == 5, "Every renamed identifier is reported");
+}
+
+static void checkSchema() {
+    IniLib::IniSchema schema;
+    schema.addKey("node*", "port", IniLib::IniSchema::Type::Integer, true, 1, 65535);
+    schema.addKey("node*", "ratio", IniLib::IniSchema::Type::Decimal, false, 0, 1);
+    schema.addKey("node*", "enabled", IniLib::IniSchema::Type::Bool, false);
+    schema.addKey("server", "name", IniLib::IniSchema::Type::Any);
+    schema.setAllowUnknownKeys(false);
+
+    IniLib::IniFile valid;
+    valid.set("Node1", "port", "80");
+    valid.set("Node1", "ratio", "0.5");
+    valid.set("Server", "name", "main");
+    check(schema.validate(valid).empty(), "A file following the schema has no violations");
+
+    // The same contents, inserted in different orders, must give the same report
+    auto makeInvalid = [](bool reversed) {
+        IniLib::IniFile file;
+        vector<array<string, 3>> entries = {
+            { "node1", "port", "0x10000" }, { "node1", "ratio", "nan" }, { "node2", "ratio", "inf" },
+            { "node2", "enabled", "maybe" }, { "node2", "extra", "1" }, { "node3", "port", "eighty" } };
+        if (reversed) reverse(entries.begin(), entries.end());
+        for (const array<string, 3>& entry : entries) file.set(entry[0], entry[1], entry[2]);
+        return file;
+    };
+    vector<IniLib::IniSchemaViolation> violations = schema.validate(makeInvalid(false));
+    vector<IniLib::IniSchemaViolation> reversed = schema.validate(makeInvalid(true));
+
+    using Kind = IniLib::IniSchemaViolation::Kind;
+    auto count = [&](Kind kind) {
+        return count_if(violations.begin(), violations.end(), [&](const IniLib::IniSchemaViolation& violation) { return violation.kind == kind; });
+    };
+    check(count(Kind::OutOfRange) == 3, "Out of range, nan and inf values are reported");
+    check(count(Kind::InvalidType) == 2, "Values of the wrong type are reported");
+    check(count(Kind::MissingKey) == 1 && count(Kind::UnknownKey) == 1, "Missing and unknown keys are reported");
+    check(count(Kind::MissingSection) == 1, "Missing sections without wildcards are reported");
+
+    bool sameOrder = violations.size() == reversed.size();
+    for (size_t i = 0; sameOrder && i < violations.size(); ++i) {
+        sameOrder = violations[i].section == reversed[i].section && violations[i].key == reversed[i].key && violations[i].kind == reversed[i].kind;
+    }
+    check(sameOrder, "Violations are reported in the same order whatever the insertion order");
+
+    // Validating while loading gives the report of validate on the loaded file,
+    // also for repeated keys and for sections with a header only
+    string path = tempFile("inilib_schema.ini");
+    { ofstream out(path); out << "[node1]\nport=eighty\nenabled=maybe\nport=80\n[server]\n[node2]\nport=0\nextra=1\n"; }
+    IniLib::IniFile loaded;
+    vector<IniLib::IniSchemaViolation> loadViolations;
+    loaded.load(path, schema, loadViolations);
+    vector<IniLib::IniSchemaViolation> afterLoad = schema.validate(loaded);
+    bool sameReport = loadViolations.size() == afterLoad.size() && loadViolations.size() == 4;
+    for (size_t i = 0; sameReport && i < afterLoad.size(); ++i) {
+        sameReport = loadViolations[i].section == afterLoad[i].section && loadViolations[i].key == afterLoad[i].key && loadViolations[i].kind == afterLoad[i].kind;
+    }
+    check(sameReport, "Load-time validation reports the same violations as validate");
+    remove(path.c_str());
+}
+
+static void checkColumn() {
+    IniLib::IniFile file;
+    for (int i = 0; i < 100; ++i) {
+        file.set("node" + to_string(i), "id", to_string(i));
+    }
+    file.set("other", "id", "-1");
+    file.set("node100", "name", "no id");
+
+    IniLib::IniColumn<int> column = file.getColumn<int>("ID", "Node*");
+    bool matches = column.values.size() == 100 && column.sections.size() == 100;
+    for (size_t i = 0; matches && i < column.values.size(); ++i) {
+        matches = column.sections[i] == "node" + to_string(column.values[i]);
+    }
+    check(matches, "getColumn reads the key from every matching section, with its section name");
+
+    IniLib::IniColumn<int> threaded = file.getColumn<int>("id", "node*", 4);
+    check(threaded.values == column.values && threaded.sections == column.sections, "getColumn gives the same result on several threads");
+
+    int buffer[8];
+    string_view names[8];
+    check(file.getColumnInto("id", "node*", buffer, 8, names) == 8 && names[3] == "node" + to_string(buffer[3]), "getColumnInto stops at the buffer capacity");
+
+    file.set("node50", "id", "fifty");
+    checkThrows<IniLib::IniValueConvertException>([&] { file.getColumn<int>("id", "node*", 4); }, "getColumn rethrows conversion errors from its threads");
+}
+
+static void checkIntegerConvert() {
+    check(IniLib::IniValue("9223372036854775807").getAs<long long>() == INT64_MAX, "long long reads its largest value");
+    check(IniLib::IniValue("18446744073709551615").getAs<unsigned long long>() == UINT64_MAX, "unsigned long long reads its largest value");
+    check(IniLib::IniValue("0x10").getAs<int>() == 16 && IniLib::IniValue("010").getAs<int>() == 8, "Integers are read as hexadecimal and octal");
+    checkThrows<IniLib::IniValueConvertException>([] { IniLib::IniValue("40000").getAs<short>(); }, "Integers too large for the type are rejected");
+    checkThrows<IniLib::IniValueConvertException>([] { IniLib::IniValue("-1").getAs<unsigned>(); }, "Negative values are rejected for unsigned types");
+    checkThrows<IniLib::IniValueConvertException>([] { IniLib::IniValue("12abc").getAs<int>(); }, "Trailing characters are rejected");
+
+    check(IniLib::IniValue("RAINY").getAs<Weather>() == Weather::Rainy, "Named enumerations are read by name, ignoring case");
+    check(IniLib::IniValue("0").getAs<Weather>() == Weather::Sunny, "Named enumerations are also read by value");
+    checkThrows<IniLib::IniValueConvertException>([] { IniLib::IniValue("cloudy").getAs<Weather>(); }, "Unknown enumeration names are rejected");
+    checkThrows<IniLib::IniValueConvertException>([] { IniLib::IniValue("300").getAs<Level>(); }, "Enumeration values are range-checked against the underlying type");
+    check(IniLib::IniValueConvert<Weather>::encode(Weather::Rainy) == "rainy" && IniLib::IniValueConvert<Level>::encode(Level(7)) == "7",
+        "Enumerations are written by name, or by value without names");
+}
+
+static void checkFixed() {
+    using Fixed = IniLib::IniFixed<3>;
+    static_assert([] { Fixed fixed; return IniLib::parseFixed("0.1", fixed) && fixed.raw() == 100; }(), "parseFixed is usable at compile time");
+
+    check(IniLib::IniValue("0.1").getAs<Fixed>().raw() == 100, "Decimals are read exactly");
+    check(IniLib::IniValue("2.0005").getAs<Fixed>().raw() == 2001 && IniLib::IniValue("-2.0005").getAs<Fixed>().raw() == -2001,
+        "Extra digits are rounded half away from zero");
+    check(IniLib::IniValue("1.2344").getAs<Fixed>().raw() == 1234, "Extra digits below one half are dropped");
+    check(IniLib::IniValue(".5").getAs<Fixed>().raw() == 500 && IniLib::IniValue("+7").getAs<Fixed>().raw() == 7000,
+        "Signs and a missing integer part are accepted");
+    checkThrows<IniLib::IniValueConvertException>([] { IniLib::IniValue("9223372036854775.808").getAs<Fixed>(); }, "Values beyond the 64-bit range are rejected");
+    checkThrows<IniLib::IniValueConvertException>([] { IniLib::IniValue("1e3").getAs<Fixed>(); }, "Exponents are rejected");
+    checkThrows<IniLib::IniValueConvertException>([] { IniLib::IniValue(".").getAs<Fixed>(); }, "A lone point is rejected");
+
+    check(IniLib::IniValueConvert<Fixed>::encode(Fixed::fromRaw(-1500)) == "-1.5" && IniLib::IniValueConvert<Fixed>::encode(Fixed::fromRaw(42000)) == "42",
+        "Fixed-point values are written without trailing zeros");
+}
+
+static void checkNativeStorage() {
+    IniLib::IniValue value;
+    value = 42;
+    check(value.getAs<int>() == 42 && value.getAs<long long>() == 42 && value.getString() == "42", "Native integers decode as their own and other types");
+
+    IniLib::IniValue copy = value;
+    copy = 7;
+    check(value.getString() == "42" && copy.getString() == "7", "Copies of native values are independent");
+
+    IniLib::IniValue array;
+    array = vector<short>({ 1, 2, 3 });
+    check(array.length() == 3 && array.getVectorAs<short>() == vector<short>({ 1, 2, 3 }), "Native arrays decode element by element");
+    array.append("4");
+    check(array.getVector() == vector<string>({ "1", "2", "3", "4" }), "Appending to a native array keeps its elements");
+
+    IniLib::IniValue source;
+    source = vector<int>({ 4, 5 });
+    IniLib::IniValue target(std::move(source));
+    check(source.length() == 0 && source.getString().empty() && target.getAs<int>() == 4, "A moved-from native value is empty");
+    source = 6;
+    target = std::move(source);
+    check(source.length() == 0 && source.getString().empty() && target.getString() == "6", "A native value moved by assignment leaves its source empty");
+
+    // Several readers encoding the text of the same value at once
+    IniLib::IniValue shared;
+    shared = vector<long long>({ 123456789, -1 });
+    vector<string> seen(8);
+    vector<thread> readers;
+    for (size_t i = 0; i < seen.size(); ++i) {
+        readers.emplace_back([&, i] { seen[i] = shared.getString(); });
+    }
+    for (thread& reader : readers) reader.join();
+    check(all_of(seen.begin(), seen.end(), [](const string& text) { return text == "123456789, -1"; }), "Concurrent const reads encode a native value once");
+}
+
+static void checkBoolDecoding() {
+    bool parsed = false;
+    check(IniLib::parseBool("true", parsed) && parsed && IniLib::parseBool("0", parsed) && !parsed, "parseBool reads true, false, 1 and 0");
+    check(!IniLib::parseBool("TRUE", parsed) && !IniLib::parseBool("yes", parsed) && !IniLib::parseBool("", parsed), "parseBool rejects other tokens");
+
+    // 70 flags, set on every third element, spanning two words
+    vector<string> flags;
+    for (int i = 0; i < 70; ++i) flags.push_back(i % 3 == 0 ? "true" : "0");
+    uint64_t words[2] = { ~0ull, ~0ull };
+    IniLib::DecodeResult result = IniLib::IniValue(flags).decodeBitsInto(words, 128);
+    bool bitsMatch = result.success && result.count == 70;
+    for (int i = 0; bitsMatch && i < 70; ++i) {
+        bitsMatch = ((words[i / 64] >> (i % 64)) & 1) == (i % 3 == 0 ? 1u : 0u);
+    }
+    check(bitsMatch && (words[1] >> 6) == 0, "decodeBitsInto packs one bit per element and clears the rest of each word");
+
+    flags[67] = "maybe";
+    words[1] = ~0ull;
+    result = IniLib::IniValue(flags).decodeBitsInto(words, 128);
+    check(result.count == 67 && !result.success && words[1] == 0b100, "decodeBitsInto stops at the first invalid element, keeping the bits before it");
+
+    // vector<bool> isn't stored natively, so this goes through the text elements
+    IniLib::IniValue assigned;
+    assigned = vector<bool>({ true, false, true });
+    check(assigned.decodeBitsInto(words, 64).count == 3 && words[0] == 0b101, "decodeBitsInto reads assigned bool vectors");
+
+    IniLib::IniArray<char> chars = IniLib::IniValue({ "a", "b", "c" }).getArrayAs<char>();
+    check(chars.size() == 3 && chars[2] == 'c', "Char arrays decode one character per element");
+    checkThrows<IniLib::IniValueConvertException>([] { IniLib::IniValue({ "a", "bc" }).getArrayAs<char>(); }, "Elements longer than one character are rejected");
+}
+
+static void checkGetMany() {
+    IniLib::IniFile file;
+    file.set("A", "x", "1");
+    file.set("B", "y", "2");
+    file.set("A", "z", "3");
+
+    // Sections interleaved, a missing key and a missing section
+    IniLib::IniQuery query{ { "a", "X" }, { "b", "y" }, { "A", "missing" }, { "a", "z" } };
+    size_t slot = query.add("C", "x");
+    check(slot == 4 && query.size() == 5, "IniQuery::add returns the slot of the new lookup");
+
+    const IniLib::IniValue* results[5];
+    size_t found = file.getMany(query, results);
+    check(found == 3, "getMany counts the values found");
+    check(results[0] == file.find("a", "x") && results[1] == file.find("b", "y") && results[3] == file.find("a", "z"),
+        "getMany stores each value in the slot of its lookup");
+    check(results[2] == nullptr && results[4] == nullptr, "getMany stores null for missing keys and sections");
+}
+
+static void checkSave() {
+    IniLib::IniFile file;
+    file.set("First", "list", { "a", "b", "c" });
+    file.set("First", "empty", "");
+    file.set("Second", "number", "12");
+    string expected = file.saveToString();
+    check(expected.find("[first]\n") != string::npos && expected.find("list=a, b, c\n") != string::npos && expected.find("empty=\n") != string::npos,
+        "saveToString writes headers and key=value lines");
+
+    string path = tempFile("inilib_save.ini");
+    check(file.save(path), "save writes the file");
+    IniLib::IniFile loaded;
+    // Sections and keys are unordered, so only the size of the text is compared
+    check(loaded.load(path) && loaded.saveToString().size() == expected.size() && loaded.sectionCount() == 2 && loaded.keyCount("first") == 2,
+        "A saved file loads back to the same sections and keys");
+    check(loaded["first"]["list"].getVector() == vector<string>({ "a", "b", "c" }) && loaded["second"]["number"].getAs<int>() == 12,
+        "A saved file loads back to the same values");
+    remove(path.c_str());
+}
+
+static void checkAtomicSave() {
+    filesystem::path directory = filesystem::temp_directory_path() / "inilib_atomic";
+    filesystem::remove_all(directory);
+    filesystem::create_directory(directory);
+    string first = (directory / "first.ini").string(), second = (directory / "second.ini").string();
+
+    IniLib::IniFile file;
+    file.set("section", "key", "old");
+    { ofstream existing(first); existing << "previous contents"; }
+    check(file.saveAtomic(first) && readFile(first) == file.saveToString(), "saveAtomic replaces an existing file");
+
+#ifndef _WIN32
+    // The temporary file is created with the default permissions, not those of the replaced file
+    filesystem::perms ownerOnly = filesystem::perms::owner_read | filesystem::perms::owner_write;
+    filesystem::permissions(first, ownerOnly);
+    check(file.saveAtomic(first) && filesystem::status(first).permissions() == ownerOnly, "saveAtomic keeps the permissions of the replaced file");
+#endif
+
+    IniLib::IniFile other;
+    other.set("other", "key", "value");
+    check(IniLib::IniFile::saveAll({ { first, &other }, { second, &file } }), "saveAll saves every file");
+    check(readFile(first) == other.saveToString() && readFile(second) == file.saveToString(), "saveAll writes each file to its own path");
+
+    string missing = (directory / "missing" / "file.ini").string();
+    check(!IniLib::IniFile::saveAll({ { second, &other }, { missing, &file } }), "saveAll fails when a file cannot be written");
+    check(readFile(second) == file.saveToString(), "Files are not replaced when writing any of them failed");
+
+    size_t entries = distance(filesystem::directory_iterator(directory), filesystem::directory_iterator());
+    check(entries == 2, "No temporary files are left behind");
+    filesystem::remove_all(directory);
+}
+
+static void checkDirtyTracking() {
+    string path = tempFile("inilib_dirty.ini");
+    { ofstream out(path); out << "[a]\nx=1\ny=2\n\n[b]\nz=3\n"; }
+
+    IniLib::IniFile file;
+    file.setTrackChanges(true);
+    check(file.load(path) && !file.isDirty(), "A freshly loaded file is clean");
+
+    file.set("a", "x", "10");
+    check(file.isDirty() && file.isDirty("a") && !file.isDirty("b"), "Only the modified section is dirty");
+    check(file.find("a")->isDirty("x") && !file.find("a")->isDirty("y"), "Only the modified key is dirty");
+
+    check(file.saveChanges(path) && !file.isDirty(), "saveChanges leaves the file clean");
+    check(readFile(path) == "[a]\nx=10\ny=2\n\n[b]\nz=3\n", "saveChanges writes the modified value");
+
+    // Nothing changed since, so the file must not be touched
+    { ofstream out(path); out << "sentinel"; }
+    check(file.saveChanges(path) && readFile(path) == "sentinel", "saveChanges performs no I/O without changes");
+
+    // Lookups alone are not modifications, assignments through the returned references are
+    file.find("a", "y");
+    file["a"]["y"].getString();
+    check(!file.isDirty(), "Lookups through non-const accessors leave the file clean");
+    file["a"]["y"] = 20;
+    check(file.isDirty("a") && file.find("a")->isDirty("y"), "Assigning through a reference marks the key dirty");
+    IniLib::IniSection copy = *file.find("a");
+    copy["x"].append("11");
+    check(copy.isDirty("x") && !file.find("a")->isDirty("x"), "Copied sections record their own modifications");
+    check(file.saveChanges(path) && !file.isDirty(), "saveChanges writes the assigned value");
+
+    file.removeSection("b");
+    check(file.isDirty() && file.isDirty("b"), "A removed section is reported as modified");
+    check(file.saveChanges(path) && !file.isDirty() && !file.isDirty("b"), "Removing a section makes the file dirty until saved");
+
+    // Without tracking, the loaded text isn't kept and the whole file is written
+    IniLib::IniFile untracked;
+    check(!untracked.tracksChanges() && untracked.load(path), "Change tracking is off by default");
+    { ofstream out(path); out << "sentinel"; }
+    check(untracked.saveChanges(path) && readFile(path) == untracked.saveToString(), "saveChanges writes the whole file without tracking");
+    remove(path.c_str());
+}
+
+static void checkPreservedFormat() {
+    const string original = "; settings\n[Window]\nwidth = 1,2   ; inline\n\n# sizes\nheight=3\n[Empty]\n[Other]\nname=x";
+    string path = tempFile("inilib_preserve.ini");
+    { ofstream out(path); out << original; }
+
+    IniLib::IniFile file;
+    file.setPreserveFormat(true);
+    check(file.load(path) && file.saveToString() == original, "An unmodified file is rendered byte for byte");
+
+    // Reading through non-const accessors must not reformat "1,2" as "1, 2"
+    string width = file["window"]["width"].getString();
+    file.find("other", "name");
+    check(width == "1, 2" && file.saveToString() == original, "Values that were only read keep their original bytes");
+
+    // Same length, different bytes: a patch that writes nothing leaves them in place
+    { ofstream out(path); out << string(original.size(), '-'); }
+    check(file.saveChanges(path) && readFile(path) == string(original.size(), '-'), "saveChanges writes nothing after a read-only session");
+    { ofstream out(path); out << original; }
+
+    file["window"]["height"] = 30;
+    file.set("window", "depth", "4");
+    file.removeKey("other", "name");
+    file.set("Added", "key", "value");
+    check(file.saveToString() == "; settings\n[Window]\nwidth = 1,2   ; inline\n\n# sizes\nheight=30\ndepth=4\n[Empty]\n[Other]\n\n[added]\nkey=value\n\n",
+        "Only modified entries are re-rendered, new keys follow their section and new sections are separated by a blank line");
+
+    // Added lines follow the line ending of the loaded file
+    { ofstream out(path, ios::binary); out << "[a]\r\nx=1\r\n"; }
+    IniLib::IniFile crlf;
+    crlf.setPreserveFormat(true);
+    crlf.load(path);
+    crlf.set("a", "y", "2");
+    crlf.set("b", "z", "3");
+    check(crlf.saveToString() == "[a]\r\nx=1\r\ny=2\r\n\r\n[b]\r\nz=3\r\n\r\n", "Added keys and sections keep CRLF line endings");
+    remove(path.c_str());
+}
+
+static void checkParallelSave() {
+    IniLib::IniFile file;
+    for (int i = 0; i < 200; ++i) {
+        file.set("section" + to_string(i), "index", to_string(i));
+        file.set("section" + to_string(i), "values", { "a", "b" });
+    }
+    string expected = file.saveToString();
+
+    ostringstream streamed;
+    check(file.saveToStream(streamed, 4) && streamed.str() == expected, "Sections rendered on several threads are joined in order");
+
+    string path = tempFile("inilib_parallel.ini");
+    check(file.save(path, 7) && readFile(path) == expected, "save on several threads writes the same bytes as on one");
+
+    IniLib::IniFile small;
+    small.set("only", "key", "value");
+    check(small.save(path, 8) && readFile(path) == small.saveToString(), "save with more threads than sections falls back to one thread");
+    remove(path.c_str());
+}
+
+static void checkOutputTargets() {
+    IniLib::IniFile file;
+    file.set("a", "x", "1");
+    file.set("b", "y", { "2", "3" });
+    string expected = file.saveToString();
+
+    string buffer = "prefix\n";
+    file.saveToBuffer(buffer);
+    check(buffer == "prefix\n" + expected, "saveToBuffer appends to the existing contents");
+
+    string joined;
+    size_t chunks = 0;
+    file.saveToSink([&](string_view chunk) { joined.append(chunk); ++chunks; });
+    check(joined == expected && chunks == 2, "saveToSink passes one chunk per section");
+
+    ostringstream stream;
+    check(file.saveToStream(stream) && stream.str() == expected, "saveToStream writes the same bytes");
+    ostringstream failed;
+    failed.setstate(ios::badbit);
+    check(!file.saveToStream(failed), "saveToStream reports a failed stream");
+}
+
+static void checkWriter() {
+    // The same contents built in an IniFile, written in its sorted order
+    IniLib::IniFile file;
+    file.setSortedOutput(true);
+    file["Alpha"]["Count"] = -42;
+    file["Alpha"]["list"] = vector<int>({ 1, 2, 3 });
+    file["alpha"]["ratio"] = 1.5;
+    file["Beta"]["name"] = "text";
+    file["beta"]["values"] = { "x", "y" };
+
+    ostringstream written;
+    {
+        // A small buffer, so the output is flushed several times
+        IniLib::IniWriter writer(written, 16);
+        writer.beginSection("Alpha");
+        writer.writeKey("Count", -42);
+        writer.writeKey("list", { 1, 2, 3 });
+        writer.writeKey("ratio", 1.5);
+        writer.beginSection("beta");
+        writer.writeKey("name", "text");
+        writer.writeKey("values", file["beta"]["values"]);
+        check(writer.finish(), "finish reports a successful write");
+        checkThrows<IniLib::IniFileException>([&] { writer.beginSection("late"); }, "Writing after finish throws");
+    }
+    check(written.str() == file.saveToString(), "IniWriter writes the same bytes as saveToString");
+
+    ostringstream unused;
+    IniLib::IniWriter writer(unused);
+    checkThrows<IniLib::IniFileException>([&] { writer.writeKey("key", 1); }, "Writing a key outside a section throws");
+}
+
+static void checkJournal() {
+    string path = tempFile("inilib_journal.ini"), journal = path + ".journal";
+    const string original = "; journaled\n[main]\nvalue=1\n\n[keep]\nkey=kept\n";
+    { ofstream out(path); out << original; }
+    remove(journal.c_str());
+
+    {
+        IniLib::IniFile file;
+        file.setJournal(true);
+        file.load(path);
+        // set, removeKey and removeSection record themselves; record delimiters must be escaped
+        file.set("main", "value", "line\n!keep");
+        file.set("main", "tab\tkey", "back\\slash");
+        file.set("gone", "key", "1");
+        file.removeSection("gone");
+        file["main"]["reference"] = 5;
+        file.appendJournal();
+    }
+    check(filesystem::exists(journal) && readFile(path) == original, "Edits are journaled without rewriting the file");
+    check(readFile(journal) == "=main\tvalue\tline\\n!keep\n=main\ttab\\tkey\tback\\\\slash\n=gone\tkey\t1\n!gone\n=main\treference\t5\n",
+        "Each change is journaled once, by the call that follows it");
+
+    // A record cut short by a crash is ignored
+    { ofstream out(journal, ios::app | ios::binary); out << "=main\tvalue\tpartial"; }
+
+    IniLib::IniFile replayed;
+    replayed.setJournal(true, 0);
+    replayed.load(path);
+    check(replayed.hasSection("keep") && !replayed.hasSection("gone"), "Escaped values cannot inject records");
+    check(replayed["main"]["value"].getString() == "line\n!keep" && replayed["main"]["tab\tkey"].getString() == "back\\slash",
+        "Newlines, tabs and backslashes round-trip through the journal");
+    check(replayed["main"]["reference"].getAs<int>() == 5, "appendJournal records edits made through references");
+
+    // A threshold of 0 compacts on the next record
+    replayed.removeKey("keep", "key");
+    IniLib::IniFile compacted;
+    check(!filesystem::exists(journal) && compacted.load(path) && !compacted.hasKey("keep", "key") && compacted["main"]["reference"].getAs<int>() == 5,
+        "Compaction saves every change to the file and deletes the journal");
+    check(readFile(path).rfind("; journaled\n[main]\n", 0) == 0, "Compaction keeps the layout of the loaded file");
+
+    // Later records only hold what changed since the compaction
+    replayed.setJournal(true);
+    replayed.set("main", "value", "2");
+    replayed.set("main", "value", "3");
+    replayed["main"]["reference"].getString();
+    check(replayed.appendJournal() && readFile(journal) == "=main\tvalue\t2\n=main\tvalue\t3\n", "Lookups and already journaled keys are not journaled again");
+    remove(journal.c_str());
+    remove(path.c_str());
+}
+
+static void checkSortedOutput() {
+    // Names sharing their first 8 bytes, so the order is decided by the rest
+    vector<string> names = { "settings_b", "settings", "alpha", "settings_a", "settingsZ", "b" };
+    auto build = [&](bool reversed) {
+        IniLib::IniFile file;
+        file.setSortedOutput(true);
+        vector<string> order = names;
+        if (reversed) reverse(order.begin(), order.end());
+        for (const string& section : order) {
+            for (const string& key : order) file.set(section, key, "1");
+        }
+        return file.saveToString();
+    };
+    string sorted = build(false);
+    check(sorted == build(true), "Sorted output does not depend on the insertion order");
+
+    vector<string> expected = { "[alpha]", "[b]", "[settings]", "[settings_a]", "[settings_b]", "[settingsz]" };
+    size_t previous = 0;
+    bool ordered = true;
+    for (const string& header : expected) {
+        size_t position = sorted.find(header + "\n");
+        ordered = ordered && position != string::npos && position >= previous;
+        previous = position;
+    }
+    check(ordered, "Sections are written in byte order of their names");
+    check(sorted.find("[alpha]\nalpha=1\nb=1\nsettings=1\nsettings_a=1\nsettings_b=1\nsettingsz=1\n") == 0, "Keys are written in byte order of their names");
+}
+
+static void checkPatchWriting() {
+    const string original = "[a]\nfirst=1\nsecond=2\n\n[b]\nthird=3\n";
+    string path = tempFile("inilib_patch.ini"), copy = tempFile("inilib_patch_copy.ini");
+    { ofstream out(path); out << original; }
+
+    IniLib::IniFile file;
+    file.setTrackChanges(true);
+    file.load(path);
+
+    // Bytes changed behind the library's back show which ranges were rewritten
+    auto tamper = [&](const string& text) {
+        string tampered = text;
+        tampered[1] = 'X';
+        tampered[tampered.size() - 2] = 'Y';
+        ofstream out(path);
+        out << tampered;
+    };
+
+    tamper(original);
+    file.set("a", "second", "5");
+    check(file.saveChanges(path) && readFile(path) == "[X]\nfirst=1\nsecond=5\n\n[b]\nthird=Y\n", "A same-length change overwrites only the differing bytes");
+
+    tamper(readFile(path));
+    file.set("a", "second", "500");
+    check(file.saveChanges(path) && readFile(path) == "[X]\nfirst=1\nsecond=500\n\n[b]\nthird=3\n", "A longer value rewrites the file from the first difference");
+
+    file.set("a", "second", "");
+    check(file.saveChanges(path) && readFile(path) == "[X]\nfirst=1\nsecond=\n\n[b]\nthird=3\n", "A shorter file is truncated");
+
+    // Another path gets the whole file and becomes the tracked one
+    file.set("b", "third", "4");
+    check(file.saveChanges(copy) && readFile(copy) == "[a]\nfirst=1\nsecond=\n\n[b]\nthird=4\n", "saveChanges to another path writes the whole file");
+    file.set("b", "third", "6");
+    check(file.saveChanges(copy) && readFile(copy) == "[a]\nfirst=1\nsecond=\n\n[b]\nthird=6\n" && readFile(path).find("third=3") != string::npos,
+        "The other path is the one patched afterwards");
+    remove(path.c_str());
+    remove(copy.c_str());
+}
 
 int main() {
+    checkDecodeInto();
+    checkArrayAs();
+    checkViews();
+    checkMoveSet();
+    checkFind();
+    checkBinding();
+    checkKeyLiterals();
+    checkGeneratorNames();
+    checkSchema();
+    checkColumn();
+    checkIntegerConvert();
+    checkFixed();
+    checkNativeStorage();
+    checkBoolDecoding();
+    checkGetMany();
+    checkSave();
+    checkAtomicSave();
+    checkDirtyTracking();
+    checkPreservedFormat();
+    checkParallelSave();
+    checkOutputTargets();
+    checkWriter();
+    checkJournal();
+    checkSortedOutput();
+    checkPatchWriting();
+
     IniLib::IniFile ini;
 
+    // Keep the layout of the loaded file when saving it back
+    ini.setPreserveFormat(true);
+
     // Load an INI file
     if (ini.load("Test/config.ini")) {
         // Access sections and keys using []
         string value = ini["section1"]["key1"].getString();
         cout << "Key1: " << value << endl;
 
+        // Inspect the elements without copying them
+        for (string_view element : ini["section1"]["key1"].getViews()) {
+            cout << "Key1 element: " << element << endl;
+        }
+
+        // Look up a value without copying it
+        if (const IniLib::IniValue* found = ini.find("section3", "key2")) {
+            cout << "Key2 in Section3: " << found->getView() << endl;
+        }
+
         // Set a new value
         ini["section1"]["key2"] = { "new_value1", "new_value2" };
 
@@ -45,18 +819,43 @@ int main() {
         char charArray[] = { 'a', 'b', 'c' };
         ini["typeSection"]["charKey"] = charArray;
 
-        int intValue = ini["typeSection"]["intKey"].getAs<int>();
+        int intValue = ini["typeSection"_key]["intKey"_key].getAs<int>();
+
+        // Resolve several keys at once, looking up each section only once
+        IniLib::IniQuery query{ { "typeSection", "intKey" }, { "typeSection", "floatKey" }, { "Section3", "Key2" } };
+        const IniLib::IniValue* queried[3];
+        size_t queriedCount = ini.getMany(query, queried);
 
         float floatValue = ini["typeSection"]["floatKey"].getAs<float>();
 
+        // Read a decimal exactly, as thousandths
+        IniLib::IniFixed<3> fixedValue = ini["typeSection"]["floatKey"].getAs<IniLib::IniFixed<3>>();
+
         vector<short> shortVector = ini["typeSection"]["shortKey"].getVectorAs<short>();
 
-        bool* boolArray = ini["typeSection"]["boolKey"].getArrayAs<bool>();
+        IniLib::IniArray<bool> boolArray = ini["typeSection"]["boolKey"].getArrayAs<bool>();
+
+        // Pack boolean flags into a bitset, one bit per value
+        uint64_t boolBits[1] = {};
+        ini["typeSection"]["boolKey"].decodeBitsInto(boolBits, 64);
+
+        // Decode into a caller-provided buffer, without allocating
+        short shortBuffer[4] = {};
+        IniLib::DecodeResult decoded = ini["typeSection"]["shortKey"].decodeInto(shortBuffer, 4);
+
+        // Decode the whole section into a struct in one pass
+        TypeSection typeSection;
+        IniLib::decodeSection(ini["typeSection"], typeSection);
 
         cout << "Int Value: " << intValue << endl;
+        cout << "Queried Values: " << queriedCount << " of " << query.size() << endl;
+
+        cout << "Bound Values: " << typeSection.intKey << ", " << typeSection.floatKey << ", " << typeSection.shortKey.size() << endl;
 
         cout << "Float Value: " << floatValue << endl;
 
+        cout << "Fixed Value: " << fixedValue.raw() << " thousandths" << endl;
+
         cout << "Short Values: ";
         
         for (size_t i = 0; i < shortVector.size(); i++)
@@ -65,21 +864,68 @@ int main() {
         }
         cout << endl;
 
+        cout << "Decoded Shorts: " << decoded.count << (decoded.success ? "" : " (failed)") << endl;
+
         cout << "Bool Values: ";
 
-        for (size_t i = 0; i < sizeof(boolArray); i++)
+        for (size_t i = 0; i < boolArray.size(); i++)
         {
             cout << boolArray[i] << ", ";
         }
         cout << endl;
+        cout << "Bool Bits: " << boolBits[0] << endl;
+
+        // Extract one key from every matching section
+        IniLib::IniColumn<string> key2Column = ini.getColumn<string>("key2", "section*");
+        cout << "Key2 found in " << key2Column.values.size() << " sections" << endl;
+
+        // Validate the file against a schema, collecting every violation
+        IniLib::IniSchema schema;
+        schema.addKey("typeSection", "intKey", IniLib::IniSchema::Type::Integer, true, 0, 10);
+        schema.addKey("typeSection", "boolKey", IniLib::IniSchema::Type::Bool);
+        schema.addKey("section*", "missingKey", IniLib::IniSchema::Type::Any);
+        for (const IniLib::IniSchemaViolation& violation : schema.validate(ini)) {
+            cout << "Violation: [" << violation.section << "] " << violation.key << ": " << violation.message << endl;
+        }
+
+        // Sections modified since loading, which saveChanges would rewrite
+        cout << "typeSection modified: " << (ini.isDirty("typeSection") ? "yes" : "no") << endl;
+        cout << "Section2 modified: " << (ini.isDirty("Section2") ? "yes" : "no") << endl;
 
-        // Save changes to a file
+        // Save changes to a file, keeping the original layout of untouched entries
         ini.save("config_modified.ini");
 
+        // Render to memory instead, e.g. to hash or embed the configuration,
+        // sorting added sections and keys so identical contents give identical bytes
+        ini.setSortedOutput(true);
+        string serialized = ini.saveToString();
+        cout << "Serialized size: " << serialized.size() << " bytes" << endl;
+
+        // Stream a file out key by key, without building an IniFile
+        ostringstream exported;
+        {
+            IniLib::IniWriter writer(exported);
+            writer.beginSection("Export");
+            writer.writeKey("count", 3);
+            writer.writeKey("values", { 1.5, 2.5, 3.5 });
+            writer.finish();
+        }
+        cout << "Exported size: " << exported.str().size() << " bytes" << endl;
+
+        // Journal frequent edits next to the saved file, then fold them back into it
+        IniLib::IniFile tuning;
+        tuning.setJournal(true);
+        if (tuning.load("config_modified.ini")) {
+            tuning["typeSection"]["intKey"] = 7;
+            tuning.appendJournal();
+            tuning.compactJournal();
+            cout << "Tuned intKey: " << tuning["typeSection"]["intKey"].getAs<int>() << endl;
+        }
+
         // Pause and wait for input to continue
         cout << "Press any key to continue..." << endl;
         cin.get();
     }
 
-    return 0;
+    return failures == 0 ? 0 : 1;
 }
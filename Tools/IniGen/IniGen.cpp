@@ -0,0 +1,248 @@
+/*
+MIT License
+
+Copyright (c) 2024
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/*
+IniGen - generates typed accessors for IniLib from a sample INI file or a schema.
+
+Usage: IniGen <input.ini> <output.h> [--schema] [--name StructName] [--include IniBinding.h]
+
+Without --schema, member types are inferred from the sample values: bool for
+true/false, int for integers, float for decimals and std::string otherwise.
+Keys with more than one value become std::vector members.
+
+With --schema, each value names the member type instead: bool, char, short,
+int, long, float, double or string, optionally followed by [] for a vector.
+*/
+
+#include "../../IniLib.h"
+#include "IniGenNames.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <set>
+
+namespace {
+
+    /// @brief Generator options, parsed from the command line
+    struct Options {
+        std::string input;                        ///< Input INI file
+        std::string output;                       ///< Output header
+        std::string name = "Config";              ///< Name of the top-level struct
+        std::string include = "IniBinding.h";     ///< Include path of IniBinding.h in the generated header
+        bool schema = false;                      ///< Whether the input declares types instead of sample values
+    };
+
+    using IniGen::Member;
+    using IniGen::Section;
+
+    /**
+     * @brief Escapes a name for use in a C++ string literal
+     * @param name The name to escape
+     * @return std::string The escaped name
+     */
+    std::string toLiteral(const std::string& name) {
+        std::string result = "\"";
+        for (char c : name) {
+            if (c == '"' || c == '\\') result += '\\';
+            result += c;
+        }
+        return result + "\"";
+    }
+
+    bool isInteger(const std::string& str) {
+        if (str.empty()) return false;
+        char* end = nullptr;
+        std::strtol(str.c_str(), &end, 0);
+        return *end == '\0';
+    }
+
+    bool isDecimal(const std::string& str) {
+        if (str.empty()) return false;
+        char* end = nullptr;
+        std::strtod(str.c_str(), &end);
+        return *end == '\0';
+    }
+
+    bool isBoolean(const std::string& str) {
+        return str == "true" || str == "false";
+    }
+
+    /**
+     * @brief Infers the member type from sample values
+     * @param value The sample value
+     * @return std::string The C++ type
+     */
+    std::string inferType(const IniLib::IniValue& value) {
+        IniLib::IniViewRange views = value.getViews();
+        auto all = [&](bool (*predicate)(const std::string&)) {
+            return !views.empty() && std::all_of(views.begin(), views.end(),
+                [&](std::string_view element) { return predicate(std::string(element)); });
+        };
+
+        std::string type = "std::string";
+        if (all(isBoolean)) type = "bool";
+        else if (all(isInteger)) type = "int";
+        else if (all(isDecimal)) type = "float";
+
+        return value.isVector() ? "std::vector<" + type + ">" : type;
+    }
+
+    /**
+     * @brief Reads the member type from a schema declaration
+     * @param declaration The declared type, e.g. "int" or "float[]"
+     * @param type Receives the C++ type
+     * @return true if the declaration is valid, false otherwise
+     */
+    bool schemaType(std::string declaration, std::string& type) {
+        bool vector = declaration.size() > 2 && declaration.compare(declaration.size() - 2, 2, "[]") == 0;
+        if (vector) declaration.resize(declaration.size() - 2);
+
+        static const std::set<std::string> scalars = { "bool", "char", "short", "int", "long", "float", "double" };
+        if (declaration == "string") type = "std::string";
+        else if (scalars.count(declaration)) type = declaration;
+        else return false;
+
+        if (vector) type = "std::vector<" + type + ">";
+        return true;
+    }
+
+    bool parseOptions(int argc, char* argv[], Options& options) {
+        std::vector<std::string> positional;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--schema") options.schema = true;
+            else if (arg == "--name" && i + 1 < argc) options.name = argv[++i];
+            else if (arg == "--include" && i + 1 < argc) options.include = argv[++i];
+            else positional.push_back(arg);
+        }
+        if (positional.size() != 2) return false;
+        options.input = positional[0];
+        options.output = positional[1];
+        return true;
+    }
+
+    void writeHeader(std::ostream& out, const Options& options, const std::vector<Section>& sections) {
+        out << "// Generated by IniGen from " << options.input << ". Do not edit.\n\n";
+        out << "#pragma once\n\n";
+        out << "#include \"" << options.include << "\"\n\n";
+
+        for (const Section& section : sections) {
+            out << "struct " << section.type << " {\n";
+            for (const Member& member : section.members) {
+                out << "    " << member.type << " " << member.identifier << "{};\n";
+            }
+            out << "};\n\n";
+
+            out << "template<>\n";
+            out << "struct IniLib::IniBinding<" << section.type << "> {\n";
+            out << "    static constexpr auto fields = std::make_tuple(";
+            for (size_t i = 0; i < section.members.size(); ++i) {
+                const Member& member = section.members[i];
+                out << (i ? ",\n" : "\n") << "        IniLib::bindField(" << toLiteral(member.key)
+                    << ", &" << section.type << "::" << member.identifier << ")";
+            }
+            out << ");\n};\n\n";
+        }
+
+        out << "struct " << options.name << " {\n";
+        for (const Section& section : sections) {
+            out << "    " << section.type << " " << section.identifier << ";\n";
+        }
+
+        out << "\n    void decode(const IniLib::IniFile& ini) {\n";
+        out << "        using namespace IniLib::literals;\n";
+        for (const Section& section : sections) {
+            out << "        if (const IniLib::IniSection* section = ini.find(" << toLiteral(section.name) << "_key)) {\n";
+            out << "            IniLib::decodeSection(*section, " << section.identifier << ");\n";
+            out << "        }\n";
+        }
+        out << "    }\n";
+
+        out << "\n    void encode(IniLib::IniFile& ini) const {\n";
+        out << "        using namespace IniLib::literals;\n";
+        for (const Section& section : sections) {
+            out << "        IniLib::encodeSection(" << section.identifier << ", ini[" << toLiteral(section.name) << "_key]);\n";
+        }
+        out << "    }\n";
+        out << "};\n";
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: IniGen <input.ini> <output.h> [--schema] [--name StructName] [--include IniBinding.h]" << std::endl;
+        return 1;
+    }
+    if (!IniGen::isIdentifier(options.name)) {
+        std::cerr << "Invalid struct name \"" << options.name << "\": it must be a C++ identifier and not a keyword" << std::endl;
+        return 1;
+    }
+
+    IniLib::IniFile ini;
+    if (!ini.load(options.input)) {
+        std::cerr << "Cannot read " << options.input << std::endl;
+        return 1;
+    }
+
+    // Sort sections and keys, so the output doesn't depend on hash map ordering
+    std::vector<Section> sections;
+    for (const auto& sectionPair : ini) {
+        Section section;
+        section.name = sectionPair.first;
+        for (const auto& kv : sectionPair.second) {
+            Member member;
+            member.key = kv.first;
+            if (!options.schema) {
+                member.type = inferType(kv.second);
+            }
+            else if (!schemaType(kv.second.getString(), member.type)) {
+                std::cerr << "Invalid type \"" << kv.second.getString() << "\" for [" << sectionPair.first << "] " << kv.first << std::endl;
+                return 1;
+            }
+            section.members.push_back(member);
+        }
+        std::sort(section.members.begin(), section.members.end(),
+            [](const Member& a, const Member& b) { return a.key < b.key; });
+        sections.push_back(section);
+    }
+    std::sort(sections.begin(), sections.end(),
+        [](const Section& a, const Section& b) { return a.name < b.name; });
+
+    // Names mapping to the same identifier are suffixed, so the header always compiles
+    for (const std::string& message : IniGen::assignNames(sections, options.name)) {
+        std::cerr << "Warning: " << message << std::endl;
+    }
+
+    std::ofstream out(options.output);
+    if (!out.is_open()) {
+        std::cerr << "Cannot write " << options.output << std::endl;
+        return 1;
+    }
+    writeHeader(out, options, sections);
+    return 0;
+}
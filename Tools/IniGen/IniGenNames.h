@@ -0,0 +1,186 @@
+/*
+MIT License
+
+Copyright (c) 2024
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Naming rules of IniGen, turning section and key names into C++ identifiers
+ *
+ * Kept apart from the generator itself so that the tests can check them.
+ */
+namespace IniGen {
+
+    /// @brief A member of a generated struct
+    struct Member {
+        std::string key;        ///< Key name in the INI file
+        std::string identifier; ///< C++ member name
+        std::string type;       ///< C++ member type
+    };
+
+    /// @brief A generated struct, bound to one section
+    struct Section {
+        std::string name;       ///< Section name in the INI file
+        std::string identifier; ///< C++ member name in the top-level struct
+        std::string type;       ///< C++ struct name
+        std::vector<Member> members;
+    };
+
+    /**
+     * @brief Returns the C++ keywords, which cannot be used as identifiers
+     * @return const std::set<std::string>& The keywords
+     */
+    inline const std::set<std::string>& keywords() {
+        static const std::set<std::string> words = {
+            "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break",
+            "case", "catch", "char", "char8_t", "char16_t", "char32_t", "class", "compl", "concept",
+            "const", "consteval", "constexpr", "constinit", "const_cast", "continue", "co_await",
+            "co_return", "co_yield", "decltype", "default", "delete", "do", "double", "dynamic_cast",
+            "else", "enum", "explicit", "export", "extern", "false", "float", "for", "friend", "goto",
+            "if", "inline", "int", "long", "mutable", "namespace", "new", "noexcept", "not", "not_eq",
+            "nullptr", "operator", "or", "or_eq", "private", "protected", "public", "register",
+            "reinterpret_cast", "requires", "return", "short", "signed", "sizeof", "static",
+            "static_assert", "static_cast", "struct", "switch", "template", "this", "thread_local",
+            "throw", "true", "try", "typedef", "typeid", "typename", "union", "unsigned", "using",
+            "virtual", "void", "volatile", "wchar_t", "while", "xor", "xor_eq"
+        };
+        return words;
+    }
+
+    /**
+     * @brief Checks if a name can be used as a C++ identifier as it is
+     * @param name The name to check
+     * @return true if the name is a valid identifier and not a keyword, false otherwise
+     */
+    inline bool isIdentifier(const std::string& name) {
+        if (name.empty() || std::isdigit(static_cast<unsigned char>(name[0]))) return false;
+        for (unsigned char c : name) {
+            if (!std::isalnum(c) && c != '_') return false;
+        }
+        return keywords().count(name) == 0;
+    }
+
+    /**
+     * @brief Turns a section or key name into a valid C++ identifier
+     * @param name The name to convert
+     * @return std::string The identifier
+     */
+    inline std::string toIdentifier(const std::string& name) {
+        std::string result;
+        for (unsigned char c : name) {
+            result += std::isalnum(c) ? static_cast<char>(c) : '_';
+        }
+        if (result.empty() || std::isdigit(static_cast<unsigned char>(result[0]))) {
+            result.insert(0, "_");
+        }
+        if (keywords().count(result)) {
+            result += '_';
+        }
+        return result;
+    }
+
+    /**
+     * @brief Turns a section name into a struct name, capitalizing its first letter
+     * @param name The section name
+     * @return std::string The struct name
+     */
+    inline std::string toTypeName(const std::string& name) {
+        std::string result = toIdentifier(name.empty() ? "global" : name);
+        if (result[0] == '_') {
+            result.insert(0, "Section");
+        }
+        else {
+            result[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(result[0])));
+        }
+        return result;
+    }
+
+    /**
+     * @brief Makes an identifier unique by suffixing it with _2, _3 and so on, then reserves it
+     * @param identifier The identifier
+     * @param used Identifiers already taken in the same scope, receiving the result
+     * @return std::string The unique identifier
+     */
+    inline std::string makeUnique(const std::string& identifier, std::set<std::string>& used) {
+        std::string result = identifier;
+        for (int suffix = 2; used.count(result) || keywords().count(result); ++suffix) {
+            result = identifier + "_" + std::to_string(suffix);
+        }
+        used.insert(result);
+        return result;
+    }
+
+    /**
+     * @brief Assigns the C++ names of every section and member, resolving collisions
+     *
+     * Names that are already valid identifiers are assigned first, so they are kept as written
+     * and the converted ones are suffixed instead. Struct names must differ from each other and
+     * from the top-level struct. Section members must also differ from the decode and encode
+     * functions of the top-level struct.
+     *
+     * @param sections The sections, sorted by name, with their members sorted by key
+     * @param topName Name of the top-level struct, which must be a valid identifier
+     * @return std::vector<std::string> One message per renamed identifier
+     */
+    inline std::vector<std::string> assignNames(std::vector<Section>& sections, const std::string& topName) {
+        std::vector<std::string> renamed;
+        auto assign = [&](const std::string& name, const std::string& wanted, std::set<std::string>& used, const std::string& what) {
+            std::string result = makeUnique(wanted, used);
+            if (result != wanted) {
+                renamed.push_back(what + " \"" + name + "\" is named " + result + ", since " + wanted + " is taken");
+            }
+            return result;
+        };
+        auto exactFirst = [](size_t count, auto isExact) {
+            std::vector<size_t> order(count);
+            for (size_t i = 0; i < count; ++i) order[i] = i;
+            std::stable_partition(order.begin(), order.end(), isExact);
+            return order;
+        };
+
+        std::set<std::string> types = { topName };
+        std::set<std::string> sectionIdentifiers = { topName, "decode", "encode" };
+        for (size_t i : exactFirst(sections.size(), [&](size_t i) { return isIdentifier(sections[i].name); })) {
+            Section& section = sections[i];
+            std::string name = section.name.empty() ? "global" : section.name;
+            section.type = assign(section.name, toTypeName(section.name), types, "Struct of section");
+            section.identifier = assign(section.name, toIdentifier(name), sectionIdentifiers, "Section");
+        }
+
+        for (Section& section : sections) {
+            std::set<std::string> memberIdentifiers = { section.type };
+            for (size_t i : exactFirst(section.members.size(), [&](size_t i) { return isIdentifier(section.members[i].key); })) {
+                Member& member = section.members[i];
+                member.identifier = assign("[" + section.name + "] " + member.key, toIdentifier(member.key), memberIdentifiers, "Key");
+            }
+        }
+        return renamed;
+    }
+
+} // namespace IniGen